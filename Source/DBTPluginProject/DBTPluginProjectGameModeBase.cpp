@@ -1,5 +1,5 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-
-#include "DBTPluginProjectGameModeBase.h"
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "DBTPluginProjectGameModeBase.h"
+
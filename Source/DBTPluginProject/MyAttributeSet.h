@@ -1,61 +1,61 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "AttributeSet.h"
-#include "AbilitySystemComponent.h"
-#include "MyAttributeSet.generated.h"
-
-#define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
-    GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
-    GAMEPLAYATTRIBUTE_VALUE_GETTER(PropertyName) \
-    GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
-    GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
-
-UCLASS()
-class DBTPLUGINPROJECT_API UMyAttributeSet : public UAttributeSet
-{
-    GENERATED_BODY()
-
-public:
-    UMyAttributeSet();
-    
-    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Health", ReplicatedUsing = OnRep_Health)
-    FGameplayAttributeData Health;
-    ATTRIBUTE_ACCESSORS(UMyAttributeSet, Health);
-    
-    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Health", ReplicatedUsing = OnRep_MaxHealth)
-    FGameplayAttributeData MaxHealth;
-    ATTRIBUTE_ACCESSORS(UMyAttributeSet, MaxHealth);
-    
-    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Mana", ReplicatedUsing = OnRep_Mana)
-    FGameplayAttributeData Mana;
-    ATTRIBUTE_ACCESSORS(UMyAttributeSet, Mana);
-    
-    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Mana", ReplicatedUsing = OnRep_MaxMana)
-    FGameplayAttributeData MaxMana;
-    ATTRIBUTE_ACCESSORS(UMyAttributeSet, MaxMana);
-    
-    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Movement", ReplicatedUsing = OnRep_MoveSpeed)
-    FGameplayAttributeData MoveSpeed;
-    ATTRIBUTE_ACCESSORS(UMyAttributeSet, MoveSpeed);
-    
-    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
-
-protected:
-    UFUNCTION()
-    virtual void OnRep_Health(const FGameplayAttributeData& OldHealth);
-    
-    UFUNCTION()
-    virtual void OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth);
-    
-    UFUNCTION()
-    virtual void OnRep_Mana(const FGameplayAttributeData& OldMana);
-    
-    UFUNCTION()
-    virtual void OnRep_MaxMana(const FGameplayAttributeData& OldMaxMana);
-    
-    UFUNCTION()
-    virtual void OnRep_MoveSpeed(const FGameplayAttributeData& OldMoveSpeed);
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "AbilitySystemComponent.h"
+#include "MyAttributeSet.generated.h"
+
+#define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
+    GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
+    GAMEPLAYATTRIBUTE_VALUE_GETTER(PropertyName) \
+    GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
+    GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
+
+UCLASS()
+class DBTPLUGINPROJECT_API UMyAttributeSet : public UAttributeSet
+{
+    GENERATED_BODY()
+
+public:
+    UMyAttributeSet();
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Health", ReplicatedUsing = OnRep_Health)
+    FGameplayAttributeData Health;
+    ATTRIBUTE_ACCESSORS(UMyAttributeSet, Health);
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Health", ReplicatedUsing = OnRep_MaxHealth)
+    FGameplayAttributeData MaxHealth;
+    ATTRIBUTE_ACCESSORS(UMyAttributeSet, MaxHealth);
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Mana", ReplicatedUsing = OnRep_Mana)
+    FGameplayAttributeData Mana;
+    ATTRIBUTE_ACCESSORS(UMyAttributeSet, Mana);
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Mana", ReplicatedUsing = OnRep_MaxMana)
+    FGameplayAttributeData MaxMana;
+    ATTRIBUTE_ACCESSORS(UMyAttributeSet, MaxMana);
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Attributes|Movement", ReplicatedUsing = OnRep_MoveSpeed)
+    FGameplayAttributeData MoveSpeed;
+    ATTRIBUTE_ACCESSORS(UMyAttributeSet, MoveSpeed);
+    
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+    UFUNCTION()
+    virtual void OnRep_Health(const FGameplayAttributeData& OldHealth);
+    
+    UFUNCTION()
+    virtual void OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth);
+    
+    UFUNCTION()
+    virtual void OnRep_Mana(const FGameplayAttributeData& OldMana);
+    
+    UFUNCTION()
+    virtual void OnRep_MaxMana(const FGameplayAttributeData& OldMaxMana);
+    
+    UFUNCTION()
+    virtual void OnRep_MoveSpeed(const FGameplayAttributeData& OldMoveSpeed);
 };
\ No newline at end of file
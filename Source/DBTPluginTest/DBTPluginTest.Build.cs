@@ -1,66 +1,87 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-using UnrealBuildTool;
-
-public class DBTPluginTest : ModuleRules
-{
-	public DBTPluginTest(ReadOnlyTargetRules Target) : base(Target)
-	{
-		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
-		
-		PublicIncludePaths.AddRange(
-			new string[] {
-				// ... add public include paths required here ...
-			}
-			);
-				
-		
-		PrivateIncludePaths.AddRange(
-			new string[] {
-				// ... add other private include paths required here ...
-			}
-			);
-			
-		
-		PublicDependencyModuleNames.AddRange(
-			new string[]
-			{
-				"Core",
-                "CoreUObject",
-                "InputCore",
-                "Engine",
-                "AIModule",
-                "GameplayAbilities",
-                "GameplayTags",
-                "GameplayTasks",
-                "Json",
-                "JsonUtilities",
-				// ... add other public dependencies that you statically link with here ...
-			}
-			);
-			
-		
-		PrivateDependencyModuleNames.AddRange(
-			new string[]
-			{
-				"CoreUObject",
-				"Engine",
-				"Slate",
-				"SlateCore",
-                "AIModule",
-                "GameplayTasks",
-                "Json",
-                "JsonUtilities",
-				// ... add private dependencies that you statically link with here ...	
-			}
-			);
-		
-		
-		DynamicallyLoadedModuleNames.AddRange(
-			new string[]
-			{
-				// ... add any modules that your module loads dynamically here ...
-			}
-			);
-	}
-}
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class DBTPluginTest : ModuleRules
+{
+	public DBTPluginTest(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicIncludePaths.AddRange(
+			new string[] {
+				// ... add public include paths required here ...
+			}
+			);
+				
+		
+		PrivateIncludePaths.AddRange(
+			new string[] {
+				// ... add other private include paths required here ...
+			}
+			);
+			
+		
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+                "CoreUObject",
+                "InputCore",
+                "Engine",
+                "AIModule",
+                "GameplayAbilities",
+                "GameplayTags",
+                "GameplayTasks",
+                "Json",
+                "JsonUtilities",
+                "NetCore",
+                "AssetRegistry",
+				// ... add other public dependencies that you statically link with here ...
+			}
+			);
+			
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"Slate",
+				"SlateCore",
+                "AIModule",
+                "GameplayTasks",
+                "Json",
+                "JsonUtilities",
+				// ... add private dependencies that you statically link with here ...	
+			}
+			);
+		
+		
+		SetupGameplayDebuggerSupport(Target);
+
+		// Baked Behavior Tree indexes are read from the project's Config/DBTIndex at runtime
+		RuntimeDependencies.Add("$(ProjectDir)/Config/DBTIndex/...", StagedFileType.NonUFS);
+
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"UnrealEd",
+					"EditorStyle",
+					"WorkspaceMenuStructure",
+					"GraphEditor",
+					"AIGraph",
+				}
+				);
+		}
+
+		DynamicallyLoadedModuleNames.AddRange(
+			new string[]
+			{
+				// ... add any modules that your module loads dynamically here ...
+			}
+			);
+	}
+}
@@ -1,121 +1,296 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "AbilityCounterComponent.h"
-#include "Engine/Engine.h"
-
-UAbilityCounterComponent::UAbilityCounterComponent()
-{
-    PrimaryComponentTick.bCanEverTick = false;
-    bWantsInitializeComponent = true;
-}
-
-void UAbilityCounterComponent::BeginPlay()
-{
-    Super::BeginPlay();
-    GLog->Logf(ELogVerbosity::Display, TEXT("AbilityCounterComponent started for %s"), *GetOwner()->GetName());
-}
-
-int32 UAbilityCounterComponent::GetAbilityUsageCount(TSubclassOf<UGameplayAbility> AbilityClass) const
-{
-    if (!AbilityClass) return 0;
-
-    FString AbilityName = AbilityClass->GetName();
-    const int32* Count = AbilityUsageMap.Find(AbilityName);
-    return Count ? *Count : 0;
-}
-
-int32 UAbilityCounterComponent::GetAbilityUsageCountByName(const FString& AbilityClassName) const
-{
-    const int32* Count = AbilityUsageMap.Find(AbilityClassName);
-    return Count ? *Count : 0;
-}
-
-TMap<FString, int32> UAbilityCounterComponent::GetAllAbilityUsageStats() const
-{
-    return AbilityUsageMap;
-}
-
-void UAbilityCounterComponent::ResetAllCounters()
-{
-    AbilityUsageMap.Empty();
-    GLog->Logf(ELogVerbosity::Display, TEXT("AbilityCounter: All counters reset for %s"), *GetOwner()->GetName());
-}
-
-void UAbilityCounterComponent::PrintStats() const
-{
-    GLog->Logf(ELogVerbosity::Display, TEXT("=== Ability Usage Stats for %s ==="), *GetOwner()->GetName());
-
-    if (AbilityUsageMap.Num() == 0)
-    {
-        GLog->Logf(ELogVerbosity::Display, TEXT("No abilities used yet"));
-    }
-    else
-    {
-        TArray<TPair<FString, int32>> SortedStats;
-        for (const auto& Pair : AbilityUsageMap)
-        {
-            SortedStats.Add(TPair<FString, int32>(Pair.Key, Pair.Value));
-        }
-
-        SortedStats.Sort([](const TPair<FString, int32>& A, const TPair<FString, int32>& B) {
-            return A.Value > B.Value;
-            });
-
-        for (const auto& Pair : SortedStats)
-        {
-            GLog->Logf(ELogVerbosity::Display, TEXT("  %s: %d uses"), *Pair.Key, Pair.Value);
-        }
-    }
-
-    GLog->Logf(ELogVerbosity::Display, TEXT("=== End Stats ==="));
-}
-
-void UAbilityCounterComponent::DisplayStatsOnScreen(float Duration) const
-{
-    if (GEngine)
-    {
-        FString StatsText = FString::Printf(TEXT("=== Ability Stats for %s ===\n"), *GetOwner()->GetName());
-
-        if (AbilityUsageMap.Num() == 0)
-        {
-            StatsText += TEXT("No abilities used yet\n");
-        }
-        else
-        {
-            TArray<TPair<FString, int32>> SortedStats;
-            for (const auto& Pair : AbilityUsageMap)
-            {
-                SortedStats.Add(TPair<FString, int32>(Pair.Key, Pair.Value));
-            }
-
-            SortedStats.Sort([](const TPair<FString, int32>& A, const TPair<FString, int32>& B) {
-                return A.Value > B.Value;
-                });
-
-            for (const auto& Pair : SortedStats)
-            {
-                StatsText += FString::Printf(TEXT("%s: %d uses\n"), *Pair.Key, Pair.Value);
-            }
-        }
-
-        StatsText += TEXT("========================");
-
-        GEngine->AddOnScreenDebugMessage(-1, Duration, FColor::Green, StatsText);
-    }
-}
-
-void UAbilityCounterComponent::ShowAbilityStats()
-{
-    PrintStats();
-    DisplayStatsOnScreen();
-}
-
-void UAbilityCounterComponent::IncrementAbilityCounter(const FString& AbilityName)
-{
-    int32& Count = AbilityUsageMap.FindOrAdd(AbilityName);
-    Count++;
-
-    OnAbilityUsed.Broadcast(AbilityName, Count);
-
-    GLog->Logf(ELogVerbosity::Display, TEXT("AbilityCounter: %s used %d times by %s"), *AbilityName, Count, *GetOwner()->GetName());
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AbilityCounterComponent.h"
+#include "Engine/Engine.h"
+#include "Net/UnrealNetwork.h"
+
+void FAbilityUsageEntry::PostReplicatedAdd(const FAbilityUsageArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->ApplyReplicatedEntry(*this);
+    }
+}
+
+void FAbilityUsageEntry::PostReplicatedChange(const FAbilityUsageArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->ApplyReplicatedEntry(*this);
+    }
+}
+
+void FAbilityUsageEntry::PreReplicatedRemove(const FAbilityUsageArray& InArraySerializer)
+{
+    if (InArraySerializer.OwnerComponent)
+    {
+        InArraySerializer.OwnerComponent->RemoveReplicatedEntry(*this);
+    }
+}
+
+UAbilityCounterComponent::UAbilityCounterComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    bWantsInitializeComponent = true;
+
+    SetIsReplicatedByDefault(true);
+}
+
+void UAbilityCounterComponent::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    // Set after property initialization, which copies the archetype's pointer into instances
+    ReplicatedUsage.OwnerComponent = this;
+}
+
+void UAbilityCounterComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    FDoRepLifetimeParams Params;
+    Params.Condition = bReplicateToAllConnections ? COND_None : COND_OwnerOnly;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAbilityCounterComponent, ReplicatedUsage, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UAbilityCounterComponent, ResetStamps, Params);
+}
+
+int32 UAbilityCounterComponent::GetEffectiveUsageCount(const FAbilityUsageEntry& Entry) const
+{
+    uint32 LatestReset = FMath::Max(ResetStamps.GlobalResetStamp, Entry.ResetStamp);
+    if (Entry.Category < FAbilityCounterResetStamps::NumCategories)
+    {
+        LatestReset = FMath::Max(LatestReset, ResetStamps.CategoryResetStamps[Entry.Category]);
+    }
+
+    return Entry.WriteStamp >= LatestReset ? Entry.UsageCount : 0;
+}
+
+void UAbilityCounterComponent::SyncReplicatedEntry(const FAbilityUsageEntry& Entry)
+{
+    if (GetOwnerRole() != ROLE_Authority)
+    {
+        return;
+    }
+
+    int32* EntryIndex = ReplicatedUsageIndices.Find(Entry.AbilityName);
+    if (!EntryIndex)
+    {
+        ReplicatedUsage.Items.AddDefaulted();
+        EntryIndex = &ReplicatedUsageIndices.Add(Entry.AbilityName, ReplicatedUsage.Items.Num() - 1);
+    }
+
+    FAbilityUsageEntry& ReplicatedEntry = ReplicatedUsage.Items[*EntryIndex];
+    ReplicatedEntry.AbilityName = Entry.AbilityName;
+    ReplicatedEntry.UsageCount = Entry.UsageCount;
+    ReplicatedEntry.LifetimeUsageCount = Entry.LifetimeUsageCount;
+    ReplicatedEntry.Category = Entry.Category;
+    ReplicatedEntry.WriteStamp = Entry.WriteStamp;
+    ReplicatedEntry.ResetStamp = Entry.ResetStamp;
+    ReplicatedUsage.MarkItemDirty(ReplicatedEntry);
+}
+
+void UAbilityCounterComponent::ApplyReplicatedEntry(const FAbilityUsageEntry& Entry)
+{
+    FAbilityUsageEntry& LocalEntry = AbilityUsageMap.FindOrAdd(Entry.AbilityName);
+    const int32 OldCount = GetEffectiveUsageCount(LocalEntry);
+
+    LocalEntry = Entry;
+
+    const int32 NewCount = GetEffectiveUsageCount(LocalEntry);
+    if (NewCount != OldCount)
+    {
+        OnAbilityUsed.Broadcast(Entry.AbilityName, NewCount);
+    }
+}
+
+void UAbilityCounterComponent::RemoveReplicatedEntry(const FAbilityUsageEntry& Entry)
+{
+    AbilityUsageMap.Remove(Entry.AbilityName);
+}
+
+void UAbilityCounterComponent::BeginPlay()
+{
+    Super::BeginPlay();
+    GLog->Logf(ELogVerbosity::Display, TEXT("AbilityCounterComponent started for %s"), *GetOwner()->GetName());
+}
+
+int32 UAbilityCounterComponent::GetAbilityUsageCount(TSubclassOf<UGameplayAbility> AbilityClass) const
+{
+    if (!AbilityClass) return 0;
+
+    return GetAbilityUsageCountByName(AbilityClass->GetName());
+}
+
+int32 UAbilityCounterComponent::GetAbilityUsageCountByName(const FString& AbilityClassName) const
+{
+    const FAbilityUsageEntry* Entry = AbilityUsageMap.Find(AbilityClassName);
+    return Entry ? GetEffectiveUsageCount(*Entry) : 0;
+}
+
+TMap<FString, int32> UAbilityCounterComponent::GetAllAbilityUsageStats() const
+{
+    TMap<FString, int32> Stats;
+    for (const auto& Pair : AbilityUsageMap)
+    {
+        const int32 Count = GetEffectiveUsageCount(Pair.Value);
+        if (Count > 0)
+        {
+            Stats.Add(Pair.Key, Count);
+        }
+    }
+    return Stats;
+}
+
+int32 UAbilityCounterComponent::GetLifetimeAbilityUsageCountByName(const FString& AbilityClassName) const
+{
+    const FAbilityUsageEntry* Entry = AbilityUsageMap.Find(AbilityClassName);
+    return Entry ? Entry->LifetimeUsageCount : 0;
+}
+
+TMap<FString, int32> UAbilityCounterComponent::GetAllLifetimeAbilityUsageStats() const
+{
+    TMap<FString, int32> Stats;
+    for (const auto& Pair : AbilityUsageMap)
+    {
+        Stats.Add(Pair.Key, Pair.Value.LifetimeUsageCount);
+    }
+    return Stats;
+}
+
+void UAbilityCounterComponent::ResetAllCounters()
+{
+    ResetStamps.GlobalResetStamp = ++ResetStamps.Clock;
+    GLog->Logf(ELogVerbosity::Display, TEXT("AbilityCounter: All counters reset for %s"), *GetOwner()->GetName());
+}
+
+void UAbilityCounterComponent::ResetAbilityCounter(const FString& AbilityName)
+{
+    FAbilityUsageEntry* Entry = AbilityUsageMap.Find(AbilityName);
+    if (!Entry)
+    {
+        return;
+    }
+
+    Entry->ResetStamp = ++ResetStamps.Clock;
+    SyncReplicatedEntry(*Entry);
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("AbilityCounter: Counter of %s reset for %s"), *AbilityName, *GetOwner()->GetName());
+}
+
+void UAbilityCounterComponent::ResetCategoryCounters(EAbilityCategory Category)
+{
+    const int32 CategoryIndex = (int32)Category;
+    if (CategoryIndex < 0 || CategoryIndex >= FAbilityCounterResetStamps::NumCategories)
+    {
+        return;
+    }
+
+    ResetStamps.CategoryResetStamps[CategoryIndex] = ++ResetStamps.Clock;
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("AbilityCounter: %s counters reset for %s"),
+        *UAbilityCategoryUtils::CategoryToText(Category).ToString(), *GetOwner()->GetName());
+}
+
+void UAbilityCounterComponent::PrintStats() const
+{
+    GLog->Logf(ELogVerbosity::Display, TEXT("=== Ability Usage Stats for %s ==="), *GetOwner()->GetName());
+
+    const TMap<FString, int32> Stats = GetAllAbilityUsageStats();
+    if (Stats.Num() == 0)
+    {
+        GLog->Logf(ELogVerbosity::Display, TEXT("No abilities used yet"));
+    }
+    else
+    {
+        TArray<TPair<FString, int32>> SortedStats;
+        for (const auto& Pair : Stats)
+        {
+            SortedStats.Add(TPair<FString, int32>(Pair.Key, Pair.Value));
+        }
+
+        SortedStats.Sort([](const TPair<FString, int32>& A, const TPair<FString, int32>& B) {
+            return A.Value > B.Value;
+            });
+
+        for (const auto& Pair : SortedStats)
+        {
+            GLog->Logf(ELogVerbosity::Display, TEXT("  %s: %d uses"), *Pair.Key, Pair.Value);
+        }
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("=== End Stats ==="));
+}
+
+void UAbilityCounterComponent::DisplayStatsOnScreen(float Duration) const
+{
+    if (GEngine)
+    {
+        FString StatsText = FString::Printf(TEXT("=== Ability Stats for %s ===\n"), *GetOwner()->GetName());
+
+        const TMap<FString, int32> Stats = GetAllAbilityUsageStats();
+        if (Stats.Num() == 0)
+        {
+            StatsText += TEXT("No abilities used yet\n");
+        }
+        else
+        {
+            TArray<TPair<FString, int32>> SortedStats;
+            for (const auto& Pair : Stats)
+            {
+                SortedStats.Add(TPair<FString, int32>(Pair.Key, Pair.Value));
+            }
+
+            SortedStats.Sort([](const TPair<FString, int32>& A, const TPair<FString, int32>& B) {
+                return A.Value > B.Value;
+                });
+
+            for (const auto& Pair : SortedStats)
+            {
+                StatsText += FString::Printf(TEXT("%s: %d uses\n"), *Pair.Key, Pair.Value);
+            }
+        }
+
+        StatsText += TEXT("========================");
+
+        GEngine->AddOnScreenDebugMessage(-1, Duration, FColor::Green, StatsText);
+    }
+}
+
+void UAbilityCounterComponent::ShowAbilityStats()
+{
+    PrintStats();
+    DisplayStatsOnScreen();
+}
+
+void UAbilityCounterComponent::IncrementAbilityCounter(const FString& AbilityName)
+{
+    IncrementAbilityCounterInternal(AbilityName, FAbilityUsageEntry::NoCategory);
+}
+
+void UAbilityCounterComponent::IncrementAbilityCounterInCategory(const FString& AbilityName, EAbilityCategory Category)
+{
+    IncrementAbilityCounterInternal(AbilityName, (uint8)Category);
+}
+
+void UAbilityCounterComponent::IncrementAbilityCounterInternal(const FString& AbilityName, uint8 Category)
+{
+    FAbilityUsageEntry& Entry = AbilityUsageMap.FindOrAdd(AbilityName);
+    Entry.AbilityName = AbilityName;
+    if (Category != FAbilityUsageEntry::NoCategory)
+    {
+        Entry.Category = Category;
+    }
+
+    // A reset since the last write makes this the first use of a new period
+    const int32 Count = GetEffectiveUsageCount(Entry) + 1;
+    Entry.UsageCount = Count;
+    Entry.LifetimeUsageCount++;
+    Entry.WriteStamp = ResetStamps.Clock;
+
+    // Clients keep their predicted count until the authoritative entry arrives
+    SyncReplicatedEntry(Entry);
+
+    OnAbilityUsed.Broadcast(AbilityName, Count);
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("AbilityCounter: %s used %d times by %s"), *AbilityName, Count, *GetOwner()->GetName());
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTAbilityUsageTable.h"
+#include "AbilitySystemComponent.h"
+#include "UObject/UObjectGlobals.h"
+
+FDBTAbilityUsageTable* FDBTAbilityUsageTable::Instance = nullptr;
+
+FDBTAbilityUsageTable& FDBTAbilityUsageTable::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FDBTAbilityUsageTable();
+    }
+    return *Instance;
+}
+
+void FDBTAbilityUsageTable::Release()
+{
+    if (Instance)
+    {
+        delete Instance;
+        Instance = nullptr;
+    }
+}
+
+FDBTAbilityUsageTable::FDBTAbilityUsageTable()
+{
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FDBTAbilityUsageTable::PruneDestroyedAbilitySystems);
+}
+
+FDBTAbilityUsageTable::~FDBTAbilityUsageTable()
+{
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+}
+
+int32 FDBTAbilityUsageTable::IncrementUsageCount(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle)
+{
+    if (!AbilitySystem)
+    {
+        return 0;
+    }
+
+    FAbilitySystemUsage& Usage = UsageByAbilitySystem.FindOrAdd(FObjectKey(AbilitySystem));
+    Usage.AbilitySystem = AbilitySystem;
+
+    for (FSpecUsage& Spec : Usage.Specs)
+    {
+        if (Spec.Handle == Handle)
+        {
+            return ++Spec.UsageCount;
+        }
+    }
+
+    FSpecUsage& NewSpec = Usage.Specs.AddDefaulted_GetRef();
+    NewSpec.Handle = Handle;
+    NewSpec.UsageCount = 1;
+    return NewSpec.UsageCount;
+}
+
+int32 FDBTAbilityUsageTable::GetUsageCount(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle) const
+{
+    if (const FAbilitySystemUsage* Usage = UsageByAbilitySystem.Find(FObjectKey(AbilitySystem)))
+    {
+        for (const FSpecUsage& Spec : Usage->Specs)
+        {
+            if (Spec.Handle == Handle)
+            {
+                return Spec.UsageCount;
+            }
+        }
+    }
+    return 0;
+}
+
+void FDBTAbilityUsageTable::ResetUsageCount(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle)
+{
+    if (FAbilitySystemUsage* Usage = UsageByAbilitySystem.Find(FObjectKey(AbilitySystem)))
+    {
+        for (FSpecUsage& Spec : Usage->Specs)
+        {
+            if (Spec.Handle == Handle)
+            {
+                Spec.UsageCount = 0;
+                return;
+            }
+        }
+    }
+}
+
+void FDBTAbilityUsageTable::RemoveAbilitySystem(const UAbilitySystemComponent* AbilitySystem)
+{
+    UsageByAbilitySystem.Remove(FObjectKey(AbilitySystem));
+}
+
+void FDBTAbilityUsageTable::PruneDestroyedAbilitySystems()
+{
+    for (auto It = UsageByAbilitySystem.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().AbilitySystem.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
@@ -0,0 +1,256 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTAdjusterSubsystem.h"
+#include "MaxPropertiesAdjusterComponent.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "DBTMaxValuesConfig.h"
+#include "GameFramework/Character.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarDBTAdjusterFrameBudgetUs(
+    TEXT("dbt.Adjuster.FrameBudgetUs"),
+    500.0f,
+    TEXT("Microseconds per frame the adjuster scheduler may spend adjusting characters. At least one slice runs every frame while work is pending."));
+
+static TAutoConsoleVariable<int32> CVarDBTAdjusterSliceSize(
+    TEXT("dbt.Adjuster.SliceSize"),
+    8,
+    TEXT("Characters adjusted together before the frame budget is checked again. Batch mode reads, computes and writes each slice as a whole."));
+
+bool UDBTAdjusterSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UDBTAdjusterSubsystem::Deinitialize()
+{
+    Adjusters.Empty();
+    PendingPasses.Empty();
+    PendingCharacterCount = 0;
+    ScheduledCharacters.Empty();
+
+    Super::Deinitialize();
+}
+
+float UDBTAdjusterSubsystem::GetPeriod()
+{
+    const float Period = UDBTBehaviorTreeDataManager::Get().GetGlobalAdjustmentDelay();
+    return Period > 0.0f ? Period : 5.0f;
+}
+
+float UDBTAdjusterSubsystem::RegisterAdjuster(UMaxPropertiesAdjusterComponent* Adjuster)
+{
+    const float Period = GetPeriod();
+
+    for (const FScheduledAdjuster& Scheduled : Adjusters)
+    {
+        if (Scheduled.Adjuster == Adjuster)
+        {
+            return (float)(Scheduled.NextRunTime - GetWorld()->GetTimeSeconds());
+        }
+    }
+
+    // Golden ratio sequence keeps phases evenly spread however many adjusters register
+    const float Phase = FMath::Frac(RegisteredCount++ * 0.618034f) * Period;
+    const float Delay = Period + Phase;
+
+    FScheduledAdjuster& Scheduled = Adjusters.AddDefaulted_GetRef();
+    Scheduled.Adjuster = Adjuster;
+    Scheduled.NextRunTime = GetWorld()->GetTimeSeconds() + Delay;
+
+    return Delay;
+}
+
+void UDBTAdjusterSubsystem::UnregisterAdjuster(UMaxPropertiesAdjusterComponent* Adjuster)
+{
+    Adjusters.RemoveAll([Adjuster](const FScheduledAdjuster& Scheduled) { return Scheduled.Adjuster == Adjuster; });
+
+    PendingPasses.RemoveAll([this, Adjuster](const FPendingPass& Pass)
+    {
+        if (Pass.Adjuster == Adjuster)
+        {
+            ReleasePass(Pass);
+            return true;
+        }
+        return false;
+    });
+}
+
+void UDBTAdjusterSubsystem::Tick(float DeltaTime)
+{
+    QueueDuePasses(GetWorld()->GetTimeSeconds());
+    ProcessPendingPasses();
+
+    PendingPasses.RemoveAll([this](const FPendingPass& Pass)
+    {
+        if (Pass.GetRemaining() == 0 || !Pass.Adjuster.IsValid())
+        {
+            ReleasePass(Pass);
+            return true;
+        }
+        return false;
+    });
+
+    Adjusters.RemoveAllSwap([](const FScheduledAdjuster& Scheduled) { return !Scheduled.Adjuster.IsValid(); });
+
+    for (auto It = ScheduledCharacters.CreateIterator(); It; ++It)
+    {
+        if (!It->Value.bPending && !It->Key.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+bool UDBTAdjusterSubsystem::HasPendingPass(const UMaxPropertiesAdjusterComponent* Adjuster) const
+{
+    return PendingPasses.ContainsByPredicate([Adjuster](const FPendingPass& Pass) { return Pass.Adjuster == Adjuster; });
+}
+
+void UDBTAdjusterSubsystem::ReleasePass(const FPendingPass& Pass)
+{
+    for (int32 CharacterIndex = Pass.NextCharacter; CharacterIndex < Pass.Characters.Num(); CharacterIndex++)
+    {
+        if (FScheduledCharacter* Scheduled = ScheduledCharacters.Find(Pass.Characters[CharacterIndex]))
+        {
+            Scheduled->bPending = false;
+        }
+    }
+
+    PendingCharacterCount -= Pass.GetRemaining();
+}
+
+void UDBTAdjusterSubsystem::QueueDuePasses(double Now)
+{
+    const float Period = GetPeriod();
+    FDBTMaxValuesConfig::FTablePtr Config;
+
+    for (FScheduledAdjuster& Scheduled : Adjusters)
+    {
+        UMaxPropertiesAdjusterComponent* Adjuster = Scheduled.Adjuster.Get();
+
+        // A pass still being sliced postpones the next one instead of stacking up
+        if (!Adjuster || Now < Scheduled.NextRunTime || HasPendingPass(Adjuster))
+        {
+            continue;
+        }
+
+        Scheduled.NextRunTime += Period;
+        if (Scheduled.NextRunTime <= Now)
+        {
+            Scheduled.NextRunTime = Now + Period;
+        }
+
+        TArray<ACharacter*> Targets;
+        if (!Adjuster->GatherAdjustmentTargets(Targets))
+        {
+            continue;
+        }
+
+        if (!Config.IsValid())
+        {
+            Config = FDBTMaxValuesConfig::Get().GetTable();
+            if (!Config.IsValid())
+            {
+                GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: No valid config loaded from %s"), *FDBTMaxValuesConfig::GetConfigFilePath());
+                return;
+            }
+        }
+
+        // Every adjuster gathers the same characters, so each one is only taken once per period
+        const double NextRunTime = Scheduled.NextRunTime;
+        Targets.RemoveAll([this, Now, NextRunTime](ACharacter* Character)
+        {
+            FScheduledCharacter& ScheduledCharacter = ScheduledCharacters.FindOrAdd(Character);
+            if (ScheduledCharacter.bPending || Now < ScheduledCharacter.NextRunTime)
+            {
+                return true;
+            }
+
+            ScheduledCharacter.NextRunTime = NextRunTime;
+            ScheduledCharacter.bPending = true;
+            return false;
+        });
+
+        if (Targets.Num() == 0)
+        {
+            continue;
+        }
+
+        FPendingPass& Pass = PendingPasses.AddDefaulted_GetRef();
+        Pass.Adjuster = Adjuster;
+        Pass.Config = Config;
+        Pass.Characters.Append(Targets);
+
+        PendingCharacterCount += Pass.GetRemaining();
+    }
+}
+
+void UDBTAdjusterSubsystem::ProcessPendingPasses()
+{
+    if (PendingCharacterCount <= 0)
+    {
+        return;
+    }
+
+    const double BudgetSeconds = CVarDBTAdjusterFrameBudgetUs.GetValueOnGameThread() * 1e-6;
+    const int32 SliceSize = FMath::Max(1, CVarDBTAdjusterSliceSize.GetValueOnGameThread());
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<ACharacter*> Slice;
+    for (FPendingPass& Pass : PendingPasses)
+    {
+        UMaxPropertiesAdjusterComponent* Adjuster = Pass.Adjuster.Get();
+        if (!Adjuster)
+        {
+            continue;
+        }
+
+        // A slice only contains characters of one pass
+        while (Pass.NextCharacter < Pass.Characters.Num())
+        {
+            Slice.Reset();
+            const int32 SliceEnd = FMath::Min(Pass.NextCharacter + SliceSize, Pass.Characters.Num());
+            for (; Pass.NextCharacter < SliceEnd; Pass.NextCharacter++)
+            {
+                if (FScheduledCharacter* Scheduled = ScheduledCharacters.Find(Pass.Characters[Pass.NextCharacter]))
+                {
+                    Scheduled->bPending = false;
+                }
+                if (ACharacter* Character = Pass.Characters[Pass.NextCharacter].Get())
+                {
+                    Slice.Add(Character);
+                }
+                PendingCharacterCount--;
+            }
+
+            if (Slice.Num() > 0)
+            {
+                Adjuster->AdjustCharacters(Slice, *Pass.Config);
+            }
+
+            if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+            {
+                return;
+            }
+        }
+    }
+}
+
+ETickableTickType UDBTAdjusterSubsystem::GetTickableTickType() const
+{
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UDBTAdjusterSubsystem::IsTickable() const
+{
+    return Adjusters.Num() > 0;
+}
+
+TStatId UDBTAdjusterSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDBTAdjusterSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTAdjustmentPreview.h"
+#include "DBTMaxAttributeAdjuster.h"
+#include "AbilitySystemComponent.h"
+#include "Async/Async.h"
+#include "GameFramework/Character.h"
+#include "Engine/Engine.h"
+
+void FDBTAdjustmentDiff::DumpToLog() const
+{
+    GLog->Logf(ELogVerbosity::Display, TEXT("=== Max Properties Adjustment Preview (%d characters) ==="), Characters.Num());
+
+    for (const FDBTCharacterAdjustmentDiff& CharacterDiff : Characters)
+    {
+        GLog->Logf(ELogVerbosity::Display, TEXT("%s: coefficient %f"), *CharacterDiff.CharacterName.ToString(), CharacterDiff.Coefficient);
+
+        for (const FDBTMaxPropertyChange& Change : CharacterDiff.Changes)
+        {
+            GLog->Logf(ELogVerbosity::Display, TEXT("  %s: %f -> %f"), *Change.PropertyName.ToString(), Change.OldValue, Change.NewValue);
+        }
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("=== End Preview ==="));
+}
+
+TFuture<FDBTAdjustmentDiffPtr> FDBTAdjustmentPreview::ComputeAsync(const TArray<ACharacter*>& Characters, FDBTMaxValuesConfig::FTablePtr Config)
+{
+    TSharedRef<FDBTAdjustmentDiff, ESPMode::ThreadSafe> Diff = MakeShared<FDBTAdjustmentDiff, ESPMode::ThreadSafe>();
+    FDBTMaxAttributeAdjuster& AttributeAdjuster = FDBTMaxAttributeAdjuster::Get();
+
+    // Snapshot: the worker never touches an actor
+    for (ACharacter* Character : Characters)
+    {
+        if (!Character)
+        {
+            continue;
+        }
+
+        FDBTCharacterAdjustmentDiff CharacterDiff;
+        CharacterDiff.Character = Character;
+        CharacterDiff.CharacterName = Character->GetFName();
+
+        if (UAbilitySystemComponent* AbilitySystem = AttributeAdjuster.FindMaxAttributes(Character, CharacterDiff.AttributeLayout))
+        {
+            CharacterDiff.AbilitySystem = AbilitySystem;
+            for (const FGameplayAttribute& Attribute : CharacterDiff.AttributeLayout->Attributes)
+            {
+                CharacterDiff.Changes.Add(FDBTMaxPropertyChange{ FName(*Attribute.GetName()), AbilitySystem->GetNumericAttributeBase(Attribute), 0.0 });
+            }
+        }
+        else
+        {
+            FDBTMaxPropertyLayoutRef Layout = FDBTMaxPropertyLayoutCache::Get().GetLayout(Character->GetClass());
+            CharacterDiff.PropertyLayout = Layout;
+            for (const FDBTMaxPropertyEntry& Entry : Layout->Properties)
+            {
+                CharacterDiff.Changes.Add(FDBTMaxPropertyChange{ Entry.Name, FDBTMaxPropertyLayout::ReadValue(Character, Entry), 0.0 });
+            }
+        }
+
+        if (CharacterDiff.Changes.Num() > 0)
+        {
+            Diff->Characters.Add(MoveTemp(CharacterDiff));
+        }
+    }
+
+    return Async(EAsyncExecution::ThreadPool, [Diff, Config]() -> FDBTAdjustmentDiffPtr
+    {
+        for (FDBTCharacterAdjustmentDiff& CharacterDiff : Diff->Characters)
+        {
+            ComputeCharacter(CharacterDiff, *Config);
+        }
+        return Diff;
+    });
+}
+
+void FDBTAdjustmentPreview::ComputeCharacter(FDBTCharacterAdjustmentDiff& CharacterDiff, const FDBTMaxValuesTable& Config)
+{
+    double SumDifferences = 0.0;
+    int32 ValidPropertiesCount = 0;
+
+    for (const FDBTMaxPropertyChange& Change : CharacterDiff.Changes)
+    {
+        const double FileValue = Config.GetValue(Change.PropertyName);
+        if (FileValue != 0.0)
+        {
+            SumDifferences += FMath::Abs(Change.OldValue - FileValue);
+            ValidPropertiesCount++;
+        }
+    }
+
+    CharacterDiff.Coefficient = 1.0;
+    if (ValidPropertiesCount > 0 && SumDifferences > 0.0)
+    {
+        CharacterDiff.Coefficient = SumDifferences / ValidPropertiesCount;
+    }
+
+    for (FDBTMaxPropertyChange& Change : CharacterDiff.Changes)
+    {
+        Change.NewValue = Change.OldValue * CharacterDiff.Coefficient;
+    }
+}
+
+int32 FDBTAdjustmentPreview::Commit(const FDBTAdjustmentDiff& Diff)
+{
+    check(IsInGameThread());
+
+    int32 AdjustedCount = 0;
+    for (const FDBTCharacterAdjustmentDiff& CharacterDiff : Diff.Characters)
+    {
+        ACharacter* Character = CharacterDiff.Character.Get();
+        if (!Character)
+        {
+            continue;
+        }
+
+        bool bStale = false;
+
+        if (CharacterDiff.AttributeLayout.IsValid())
+        {
+            UAbilitySystemComponent* AbilitySystem = CharacterDiff.AbilitySystem.Get();
+            const TArray<FGameplayAttribute>& Attributes = CharacterDiff.AttributeLayout->Attributes;
+
+            for (int32 i = 0; AbilitySystem && !bStale && i < Attributes.Num(); i++)
+            {
+                bStale = AbilitySystem->GetNumericAttributeBase(Attributes[i]) != CharacterDiff.Changes[i].OldValue;
+            }
+
+            if (AbilitySystem && !bStale)
+            {
+                FDBTMaxAttributeAdjuster::ApplyCoefficient(*AbilitySystem, *CharacterDiff.AttributeLayout, CharacterDiff.Coefficient);
+                AdjustedCount++;
+            }
+        }
+        else if (CharacterDiff.PropertyLayout.IsValid())
+        {
+            const TArray<FDBTMaxPropertyEntry>& Properties = CharacterDiff.PropertyLayout->Properties;
+
+            for (int32 i = 0; !bStale && i < Properties.Num(); i++)
+            {
+                bStale = FDBTMaxPropertyLayout::ReadValue(Character, Properties[i]) != CharacterDiff.Changes[i].OldValue;
+            }
+
+            if (!bStale)
+            {
+                for (int32 i = 0; i < Properties.Num(); i++)
+                {
+                    FDBTMaxPropertyLayout::WriteValue(Character, Properties[i], CharacterDiff.Changes[i].NewValue);
+                }
+                AdjustedCount++;
+            }
+        }
+
+        if (bStale)
+        {
+            GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: %s changed since the preview, skipped"), *CharacterDiff.CharacterName.ToString());
+        }
+    }
+
+    return AdjustedCount;
+}
@@ -0,0 +1,428 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTAssetRegistryTags.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "DBTBehaviorTreeIndex.h"
+#include "AssetRegistryModule.h"
+#include "AIController.h"
+#include "Engine/Blueprint.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "Engine/Engine.h"
+
+const FName FDBTAssetRegistryTags::DynamicNodeCountTag(TEXT("DBTDynamicNodeCount"));
+const FName FDBTAssetRegistryTags::CategoriesTag(TEXT("DBTCategories"));
+const FName FDBTAssetRegistryTags::MaxLimitChangeTag(TEXT("DBTMaxLimitChange"));
+const FName FDBTAssetRegistryTags::DynamicTasksTag(TEXT("DBTDynamicTasks"));
+const FName FDBTAssetRegistryTags::LimitChangesTag(TEXT("DBTLimitChanges"));
+const FName FDBTAssetRegistryTags::DynamicControllersTag(TEXT("DBTDynamicControllers"));
+
+#if WITH_EDITOR
+FDelegateHandle FDBTAssetRegistryTags::ExtraObjectTagsHandle;
+FDelegateHandle FDBTAssetRegistryTags::AssetLoadedHandle;
+FDelegateHandle FDBTAssetRegistryTags::PackageSavedHandle;
+FDelegateHandle FDBTAssetRegistryTags::FilesLoadedHandle;
+TArray<TWeakObjectPtr<UObject>> FDBTAssetRegistryTags::PendingRestores;
+#endif
+
+FDBTBehaviorTreeSummary FDBTBehaviorTreeSummary::FromBehaviorTree(const UBehaviorTree* BehaviorTree)
+{
+    FDBTBehaviorTreeSummary Summary;
+    if (BehaviorTree && BehaviorTree->RootNode)
+    {
+        TSet<FString> Categories;
+        FDBTAssetRegistryTags::AccumulateComposite(BehaviorTree->RootNode, Summary, Categories);
+
+        Summary.Categories = Categories.Array();
+        Summary.Categories.Sort();
+    }
+    return Summary;
+}
+
+bool FDBTBehaviorTreeSummary::FromAssetData(const FAssetData& AssetData, FDBTBehaviorTreeSummary& OutSummary)
+{
+    FString DynamicNodeCount;
+    if (!AssetData.GetTagValue(FDBTAssetRegistryTags::DynamicNodeCountTag, DynamicNodeCount))
+    {
+        return false;
+    }
+
+    OutSummary.DynamicNodeCount = FCString::Atoi(*DynamicNodeCount);
+
+    FString MaxLimitChange;
+    AssetData.GetTagValue(FDBTAssetRegistryTags::MaxLimitChangeTag, MaxLimitChange);
+    OutSummary.MaxLimitChange = FCString::Atoi(*MaxLimitChange);
+
+    FString Categories;
+    AssetData.GetTagValue(FDBTAssetRegistryTags::CategoriesTag, Categories);
+    Categories.ParseIntoArray(OutSummary.Categories, TEXT(","));
+
+    return true;
+}
+
+void FDBTAssetRegistryTags::AccumulateComposite(const UBTCompositeNode* Composite, FDBTBehaviorTreeSummary& Summary, TSet<FString>& Categories)
+{
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+    UBTCompositeNode* MutableComposite = const_cast<UBTCompositeNode*>(Composite);
+
+    if (DataManager.HasLimitChangeForNode(MutableComposite))
+    {
+        Summary.MaxLimitChange = FMath::Max(Summary.MaxLimitChange, DataManager.GetLimitChangeForNode(MutableComposite));
+    }
+
+    for (const FBTCompositeChild& Child : Composite->Children)
+    {
+        if (Child.ChildComposite)
+        {
+            AccumulateComposite(Child.ChildComposite, Summary, Categories);
+        }
+        else if (Child.ChildTask && DataManager.GetTaskNodeIsDynamic(Child.ChildTask))
+        {
+            Summary.DynamicNodeCount++;
+
+            const FString Category = DataManager.GetTaskNodeCategory(Child.ChildTask);
+            if (!Category.IsEmpty())
+            {
+                Categories.Add(Category);
+            }
+        }
+    }
+}
+
+#if WITH_EDITOR
+static void AppendControllerEntry(UObject* Controller, TArray<FString>& InOutEntries)
+{
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+
+    const bool bDynamic = DataManager.GetAIControllerDynamicBehaviorFlag(Controller);
+    const int32 TimeLimit = DataManager.GetAIControllerTimeLimit(Controller);
+    if (bDynamic || TimeLimit > 0)
+    {
+        InOutEntries.Add(FString::Printf(TEXT("%s=%d:%d"), *Controller->GetName(), bDynamic ? 1 : 0, TimeLimit));
+    }
+}
+
+static UClass* GetAIControllerClass(const UBlueprint* Blueprint)
+{
+    UClass* GeneratedClass = Blueprint ? Blueprint->GeneratedClass : nullptr;
+    return GeneratedClass && GeneratedClass->IsChildOf(AAIController::StaticClass()) ? GeneratedClass : nullptr;
+}
+
+void FDBTAssetRegistryTags::GetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& InOutTags)
+{
+    // Tags built before the saved data is restored would overwrite it with nothing
+    UObject* PendingObject = nullptr;
+    if (ConsumePendingRestore(Object, PendingObject) && !RestoreFromTags(PendingObject))
+    {
+        PendingRestores.Add(PendingObject);
+        GLog->Logf(ELogVerbosity::Error, TEXT("DBTAssetRegistryTags: Saved dynamic behavior data of %s could not be read, its tags are left out"), *Object->GetPathName());
+        return;
+    }
+
+    if (const UBehaviorTree* BehaviorTree = Cast<UBehaviorTree>(Object))
+    {
+        const FDBTBehaviorTreeSummary Summary = FDBTBehaviorTreeSummary::FromBehaviorTree(BehaviorTree);
+
+        InOutTags.Add(UObject::FAssetRegistryTag(DynamicNodeCountTag, FString::FromInt(Summary.DynamicNodeCount), UObject::FAssetRegistryTag::TT_Numerical));
+        InOutTags.Add(UObject::FAssetRegistryTag(CategoriesTag, FString::Join(Summary.Categories, TEXT(",")), UObject::FAssetRegistryTag::TT_Alphabetical));
+        InOutTags.Add(UObject::FAssetRegistryTag(MaxLimitChangeTag, FString::FromInt(Summary.MaxLimitChange), UObject::FAssetRegistryTag::TT_Numerical));
+
+        const FDBTBehaviorTreeIndex Index = FDBTBehaviorTreeIndex::FromBehaviorTree(BehaviorTree);
+
+        TArray<FString> Entries;
+        for (const FDBTBehaviorTreeIndex::FTaskEntry& Entry : Index.DynamicTasks)
+        {
+            Entries.Add(FString::Printf(TEXT("%s=%s"), *Entry.NodeName.ToString(), *Entry.Category));
+        }
+        InOutTags.Add(UObject::FAssetRegistryTag(DynamicTasksTag, FString::Join(Entries, TEXT(",")), UObject::FAssetRegistryTag::TT_Hidden));
+
+        Entries.Reset();
+        for (const TPair<FName, int32>& Limit : Index.LimitChanges)
+        {
+            Entries.Add(FString::Printf(TEXT("%s=%d"), *Limit.Key.ToString(), Limit.Value));
+        }
+        InOutTags.Add(UObject::FAssetRegistryTag(LimitChangesTag, FString::Join(Entries, TEXT(",")), UObject::FAssetRegistryTag::TT_Hidden));
+        return;
+    }
+
+    TArray<FString> Entries;
+    if (const UClass* ControllerClass = GetAIControllerClass(Cast<UBlueprint>(Object)))
+    {
+        AppendControllerEntry(ControllerClass->GetDefaultObject(), Entries);
+    }
+    else if (const UWorld* World = Cast<UWorld>(Object))
+    {
+        if (World->PersistentLevel)
+        {
+            for (AActor* Actor : World->PersistentLevel->Actors)
+            {
+                if (Actor && Actor->IsA<AAIController>())
+                {
+                    AppendControllerEntry(Actor, Entries);
+                }
+            }
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    // Written even when empty, so clearing the last controller also clears the tag
+    InOutTags.Add(UObject::FAssetRegistryTag(DynamicControllersTag, FString::Join(Entries, TEXT(",")), UObject::FAssetRegistryTag::TT_Hidden));
+}
+
+static bool IsRestoredAsset(UObject* Object)
+{
+    return Object && (Object->IsA<UBehaviorTree>() || Object->IsA<UWorld>() || GetAIControllerClass(Cast<UBlueprint>(Object)));
+}
+
+void FDBTAssetRegistryTags::OnAssetLoaded(UObject* Object)
+{
+    if (IsRestoredAsset(Object) && !RestoreFromTags(Object))
+    {
+        PendingRestores.Add(Object);
+    }
+}
+
+void FDBTAssetRegistryTags::OnFilesLoaded()
+{
+    TArray<TWeakObjectPtr<UObject>> Pending = MoveTemp(PendingRestores);
+    for (const TWeakObjectPtr<UObject>& Object : Pending)
+    {
+        if (Object.IsValid() && !RestoreFromTags(Object.Get()))
+        {
+            PendingRestores.Add(Object);
+            GLog->Logf(ELogVerbosity::Warning, TEXT("DBTAssetRegistryTags: Saved dynamic behavior data of %s could not be read"), *Object->GetPathName());
+        }
+    }
+}
+
+bool FDBTAssetRegistryTags::ConsumePendingRestore(const UObject* Object, UObject*& OutObject)
+{
+    const int32 Index = PendingRestores.IndexOfByPredicate([Object](const TWeakObjectPtr<UObject>& Pending) { return Pending.Get() == Object; });
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutObject = PendingRestores[Index].Get();
+    PendingRestores.RemoveAtSwap(Index);
+    return true;
+}
+
+bool FDBTAssetRegistryTags::RestoreFromTags(UObject* Object)
+{
+    UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+    UWorld* World = Cast<UWorld>(Object);
+    UBehaviorTree* BehaviorTree = Cast<UBehaviorTree>(Object);
+
+    // On-disk data only: the in-memory tags of a loaded asset are regenerated from the data manager
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    const FName ObjectPath(*Object->GetPathName());
+    FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(ObjectPath, true);
+    if (!AssetData.IsValid())
+    {
+        // Assets loaded before the background scan reached them, such as the startup map
+        FString Filename;
+        if (!FPackageName::DoesPackageExist(Object->GetOutermost()->GetName(), nullptr, &Filename))
+        {
+            return true;
+        }
+
+        AssetRegistry.ScanFilesSynchronous({ Filename });
+        AssetData = AssetRegistry.GetAssetByObjectPath(ObjectPath, true);
+        if (!AssetData.IsValid())
+        {
+            return false;
+        }
+    }
+
+    if (BehaviorTree)
+    {
+        FDBTBehaviorTreeIndex::FromAssetData(AssetData).ApplyToBehaviorTree(BehaviorTree);
+        return true;
+    }
+
+    TArray<FDBTTaggedEntry> Entries;
+    ReadEntries(AssetData, DynamicControllersTag, Entries);
+    if (Entries.Num() == 0)
+    {
+        return true;
+    }
+
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+    for (const FDBTTaggedEntry& Entry : Entries)
+    {
+        bool bDynamic = false;
+        int32 TimeLimit = 0;
+        if (!ParseControllerEntry(Entry, bDynamic, TimeLimit))
+        {
+            continue;
+        }
+
+        UObject* Controller = nullptr;
+        if (Blueprint)
+        {
+            Controller = GetAIControllerClass(Blueprint)->GetDefaultObject();
+        }
+        else if (World->PersistentLevel)
+        {
+            Controller = FindObject<AAIController>(World->PersistentLevel, *Entry.Name);
+        }
+
+        if (Controller)
+        {
+            DataManager.SetAIControllerDynamicBehaviorFlag(Controller, bDynamic);
+            DataManager.SetAIControllerTimeLimit(Controller, TimeLimit);
+        }
+    }
+
+    return true;
+}
+
+void FDBTAssetRegistryTags::Register()
+{
+    if (!ExtraObjectTagsHandle.IsValid())
+    {
+        ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(&FDBTAssetRegistryTags::GetExtraObjectTags);
+    }
+
+    if (!AssetLoadedHandle.IsValid())
+    {
+        AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddStatic(&FDBTAssetRegistryTags::OnAssetLoaded);
+    }
+
+    if (!FilesLoadedHandle.IsValid())
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+        FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddStatic(&FDBTAssetRegistryTags::OnFilesLoaded);
+    }
+
+    if (!PackageSavedHandle.IsValid())
+    {
+        PackageSavedHandle = UPackage::PackageSavedEvent.AddStatic(&FDBTBehaviorTreeIndex::WriteForSavedPackage);
+    }
+}
+
+void FDBTAssetRegistryTags::Unregister()
+{
+    UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(ExtraObjectTagsHandle);
+    ExtraObjectTagsHandle.Reset();
+
+    FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+    AssetLoadedHandle.Reset();
+
+    UPackage::PackageSavedEvent.Remove(PackageSavedHandle);
+    PackageSavedHandle.Reset();
+
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+    {
+        AssetRegistryModule->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+    }
+    FilesLoadedHandle.Reset();
+    PendingRestores.Empty();
+}
+#endif
+
+void FDBTAssetRegistryTags::FindBehaviorTrees(TArray<TPair<FAssetData, FDBTBehaviorTreeSummary>>& OutTrees, bool bOnlyWithDynamicData)
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssetsByClass(UBehaviorTree::StaticClass()->GetFName(), Assets, true);
+
+    for (const FAssetData& AssetData : Assets)
+    {
+        FDBTBehaviorTreeSummary Summary;
+        if (!FDBTBehaviorTreeSummary::FromAssetData(AssetData, Summary))
+        {
+            continue;
+        }
+
+        if (!bOnlyWithDynamicData || Summary.HasDynamicData())
+        {
+            OutTrees.Emplace(AssetData, MoveTemp(Summary));
+        }
+    }
+}
+
+void FDBTAssetRegistryTags::FindControllerAssets(TArray<FAssetData>& OutAssets)
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    FARFilter Filter;
+    Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+    Filter.ClassNames.Add(UWorld::StaticClass()->GetFName());
+    Filter.bRecursiveClasses = true;
+    Filter.TagsAndValues.Add(DynamicControllersTag);
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssets(Filter, Assets);
+
+    for (const FAssetData& AssetData : Assets)
+    {
+        FString Value;
+        if (AssetData.GetTagValue(DynamicControllersTag, Value) && !Value.IsEmpty())
+        {
+            OutAssets.Add(AssetData);
+        }
+    }
+}
+
+void FDBTAssetRegistryTags::ReadEntries(const FAssetData& AssetData, FName Tag, TArray<FDBTTaggedEntry>& OutEntries)
+{
+    FString Value;
+    if (!AssetData.GetTagValue(Tag, Value))
+    {
+        return;
+    }
+
+    TArray<FString> Items;
+    Value.ParseIntoArray(Items, TEXT(","));
+
+    for (const FString& Item : Items)
+    {
+        FDBTTaggedEntry Entry;
+        if (Item.Split(TEXT("="), &Entry.Name, &Entry.Value) && !Entry.Name.IsEmpty())
+        {
+            OutEntries.Add(MoveTemp(Entry));
+        }
+    }
+}
+
+bool FDBTAssetRegistryTags::ParseControllerEntry(const FDBTTaggedEntry& Entry, bool& bOutDynamic, int32& OutTimeLimit)
+{
+    FString Flag;
+    FString TimeLimit;
+    if (!Entry.Value.Split(TEXT(":"), &Flag, &TimeLimit))
+    {
+        return false;
+    }
+
+    bOutDynamic = FCString::Atoi(*Flag) != 0;
+    OutTimeLimit = FCString::Atoi(*TimeLimit);
+    return true;
+}
+
+static FAutoConsoleCommand DBTListDynamicTreesCommand(
+    TEXT("dbt.Assets.ListDynamicTrees"),
+    TEXT("Lists Behavior Trees with dynamic behavior data using asset registry tags only."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        TArray<TPair<FAssetData, FDBTBehaviorTreeSummary>> Trees;
+        FDBTAssetRegistryTags::FindBehaviorTrees(Trees);
+
+        for (const TPair<FAssetData, FDBTBehaviorTreeSummary>& Tree : Trees)
+        {
+            GLog->Logf(ELogVerbosity::Display, TEXT("%s: %d dynamic node(s), categories [%s], max limit change %d"),
+                *Tree.Key.ObjectPath.ToString(), Tree.Value.DynamicNodeCount, *FString::Join(Tree.Value.Categories, TEXT(", ")), Tree.Value.MaxLimitChange);
+        }
+
+        GLog->Logf(ELogVerbosity::Display, TEXT("dbt.Assets.ListDynamicTrees: %d Behavior Tree(s) with dynamic data"), Trees.Num());
+    }));
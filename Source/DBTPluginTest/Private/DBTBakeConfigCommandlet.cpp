@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTBakeConfigCommandlet.h"
+#include "DBTMaxValuesConfig.h"
+#include "Misc/Parse.h"
+
+UDBTBakeConfigCommandlet::UDBTBakeConfigCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UDBTBakeConfigCommandlet::Main(const FString& Params)
+{
+    FString JsonFilePath = FDBTMaxValuesConfig::GetConfigFilePath();
+    FString BinaryFilePath = FDBTMaxValuesConfig::GetBinaryConfigFilePath();
+
+    FParse::Value(*Params, TEXT("Json="), JsonFilePath);
+    FParse::Value(*Params, TEXT("Out="), BinaryFilePath);
+
+    return FDBTMaxValuesConfig::BakeBinaryConfig(JsonFilePath, BinaryFilePath) ? 0 : 1;
+}
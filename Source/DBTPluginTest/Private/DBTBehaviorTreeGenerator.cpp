@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTBehaviorTreeGenerator.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "DBTAssetRegistryTags.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/Composites/BTComposite_Selector.h"
+#include "BehaviorTree/Composites/BTComposite_Sequence.h"
+#include "BehaviorTree/Tasks/BTTask_Wait.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "Engine/Engine.h"
+
+static void CollectGeneratedNodes(UBTCompositeNode* Composite, TArray<UObject*>& OutNodes)
+{
+    OutNodes.Add(Composite);
+
+    for (const FBTCompositeChild& Child : Composite->Children)
+    {
+        if (Child.ChildComposite)
+        {
+            CollectGeneratedNodes(Child.ChildComposite, OutNodes);
+        }
+        else if (Child.ChildTask)
+        {
+            OutNodes.Add(Child.ChildTask);
+        }
+    }
+}
+
+FDBTGeneratedBehaviorTree::FDBTGeneratedBehaviorTree(FDBTGeneratedBehaviorTree&& Other)
+{
+    *this = MoveTemp(Other);
+}
+
+FDBTGeneratedBehaviorTree& FDBTGeneratedBehaviorTree::operator=(FDBTGeneratedBehaviorTree&& Other)
+{
+    if (this != &Other)
+    {
+        Reset();
+
+        Tree.Reset(Other.Tree.Get());
+        NumComposites = Other.NumComposites;
+        NumTasks = Other.NumTasks;
+        NumDynamicTasks = Other.NumDynamicTasks;
+
+        // Ownership moved, so Other must not remove the nodes
+        Other.Tree.Reset();
+        Other.Reset();
+    }
+    return *this;
+}
+
+void FDBTGeneratedBehaviorTree::Reset()
+{
+    UBehaviorTree* GeneratedTree = Tree.Get();
+    UDBTBehaviorTreeDataManager* DataManager = UDBTBehaviorTreeDataManager::GetIfExists();
+    if (GeneratedTree && GeneratedTree->RootNode && DataManager)
+    {
+        TArray<UObject*> Nodes;
+        CollectGeneratedNodes(GeneratedTree->RootNode, Nodes);
+        DataManager->RemoveNodes(Nodes);
+    }
+
+    Tree.Reset();
+    NumComposites = 0;
+    NumTasks = 0;
+    NumDynamicTasks = 0;
+}
+
+EAbilityCategory FDBTBehaviorTreeGenerator::PickCategory(const FDBTBehaviorTreeGeneratorParams& Params, FRandomStream& Random)
+{
+    float TotalWeight = 0.0f;
+    for (float Weight : Params.CategoryWeights)
+    {
+        TotalWeight += FMath::Max(Weight, 0.0f);
+    }
+
+    float Roll = Random.FRand() * TotalWeight;
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(Params.CategoryWeights); Index++)
+    {
+        Roll -= FMath::Max(Params.CategoryWeights[Index], 0.0f);
+        if (Roll < 0.0f)
+        {
+            return (EAbilityCategory)Index;
+        }
+    }
+    return EAbilityCategory::OffensiveAction;
+}
+
+FDBTGeneratedBehaviorTree FDBTBehaviorTreeGenerator::Generate(const FDBTBehaviorTreeGeneratorParams& Params)
+{
+    FRandomStream Random(Params.Seed);
+    FDBTGeneratedBehaviorTree Result;
+
+    const FName TreeName = MakeUniqueObjectName(GetTransientPackage(), UBehaviorTree::StaticClass(), *FString::Printf(TEXT("DBTGeneratedTree_%d"), Params.Seed));
+    UBehaviorTree* Tree = NewObject<UBehaviorTree>(GetTransientPackage(), TreeName, RF_Transient);
+    Result.Tree.Reset(Tree);
+
+    const int32 FanOut = FMath::Max(1, Params.FanOut);
+    const int32 MaxNodes = FMath::Max(2, Params.MaxNodes);
+
+    auto MakeComposite = [&](bool bRoot) -> UBTCompositeNode*
+    {
+        UBTCompositeNode* Composite = nullptr;
+        if (!bRoot && Random.FRand() < Params.SequenceRatio)
+        {
+            Composite = NewObject<UBTComposite_Sequence>(Tree);
+        }
+        else
+        {
+            Composite = NewObject<UBTComposite_Selector>(Tree);
+        }
+        Result.NumComposites++;
+        return Composite;
+    };
+
+    // Metadata is grouped so each bulk setter runs once per distinct value
+    TArray<UObject*> DynamicTasksByCategory[UE_ARRAY_COUNT(Params.CategoryWeights)];
+    TMap<int32, TArray<UObject*>> CompositesByLimitChange;
+
+    Tree->RootNode = MakeComposite(true);
+    if (Params.RootLimitChangeMax > 0)
+    {
+        CompositesByLimitChange.FindOrAdd(Random.RandRange(Params.RootLimitChangeMin, Params.RootLimitChangeMax)).Add(Tree->RootNode);
+    }
+
+    // Breadth first, so a MaxNodes cap trims the deepest levels evenly instead of one branch
+    TArray<TPair<UBTCompositeNode*, int32>> Queue;
+    Queue.Emplace(Tree->RootNode, 0);
+
+    for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); QueueIndex++)
+    {
+        UBTCompositeNode* Parent = Queue[QueueIndex].Key;
+        const int32 Level = Queue[QueueIndex].Value;
+        const int32 PendingComposites = Queue.Num() - QueueIndex - 1;
+
+        for (int32 ChildIndex = 0; ChildIndex < FanOut; ChildIndex++)
+        {
+            const int32 NumNodes = Result.NumComposites + Result.NumTasks;
+
+            // Every queued composite still needs at least one child of its own
+            if (ChildIndex > 0 && NumNodes + PendingComposites >= MaxNodes)
+            {
+                break;
+            }
+
+            FBTCompositeChild& Child = Parent->Children.AddDefaulted_GetRef();
+
+            if (Level + 1 < Params.Depth && NumNodes + PendingComposites + FanOut < MaxNodes)
+            {
+                Child.ChildComposite = MakeComposite(false);
+                Queue.Emplace(Child.ChildComposite, Level + 1);
+
+                if (Random.FRand() < Params.NonRootLimitChangeFraction)
+                {
+                    CompositesByLimitChange.FindOrAdd(Random.RandRange(1, FMath::Max(1, Params.RootLimitChangeMax))).Add(Child.ChildComposite);
+                }
+            }
+            else
+            {
+                UBTTask_Wait* Task = NewObject<UBTTask_Wait>(Tree);
+                Task->WaitTime = 0.1f + Random.FRand();
+                Child.ChildTask = Task;
+                Result.NumTasks++;
+
+                if (Random.FRand() < Params.DynamicTaskFraction)
+                {
+                    DynamicTasksByCategory[(int32)PickCategory(Params, Random)].Add(Task);
+                    Result.NumDynamicTasks++;
+                }
+            }
+        }
+    }
+
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(DynamicTasksByCategory); Index++)
+    {
+        if (DynamicTasksByCategory[Index].Num() > 0)
+        {
+            DataManager.SetTaskNodesDynamicFlag(DynamicTasksByCategory[Index], true, UAbilityCategoryUtils::CategoryToText((EAbilityCategory)Index).ToString());
+        }
+    }
+
+    for (const TPair<int32, TArray<UObject*>>& Pair : CompositesByLimitChange)
+    {
+        DataManager.SetLimitChangeForNodes(Pair.Value, Pair.Key);
+    }
+
+    return Result;
+}
+
+static FAutoConsoleCommand DBTGenerateTreeCommand(
+    TEXT("dbt.Debug.GenerateTree"),
+    TEXT("Generates a transient Behavior Tree and logs generation and summary timings. Usage: dbt.Debug.GenerateTree [Depth] [FanOut] [Seed] [MaxNodes]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FDBTBehaviorTreeGeneratorParams Params;
+        if (Args.Num() > 0) Params.Depth = FCString::Atoi(*Args[0]);
+        if (Args.Num() > 1) Params.FanOut = FCString::Atoi(*Args[1]);
+        if (Args.Num() > 2) Params.Seed = FCString::Atoi(*Args[2]);
+        if (Args.Num() > 3) Params.MaxNodes = FCString::Atoi(*Args[3]);
+
+        const double GenerateStart = FPlatformTime::Seconds();
+        FDBTGeneratedBehaviorTree Generated = FDBTBehaviorTreeGenerator::Generate(Params);
+        const double GenerateSeconds = FPlatformTime::Seconds() - GenerateStart;
+
+        const double SummaryStart = FPlatformTime::Seconds();
+        const FDBTBehaviorTreeSummary Summary = FDBTBehaviorTreeSummary::FromBehaviorTree(Generated.Tree.Get());
+        const double SummarySeconds = FPlatformTime::Seconds() - SummaryStart;
+
+        GLog->Logf(ELogVerbosity::Display, TEXT("dbt.Debug.GenerateTree: %s with %d composite(s), %d task(s), %d dynamic; generated in %.2f ms, summarized in %.2f ms (%d dynamic node(s), max limit change %d)"),
+            *Generated.Tree->GetName(), Generated.NumComposites, Generated.NumTasks, Generated.NumDynamicTasks,
+            GenerateSeconds * 1000.0, SummarySeconds * 1000.0, Summary.DynamicNodeCount, Summary.MaxLimitChange);
+    }));
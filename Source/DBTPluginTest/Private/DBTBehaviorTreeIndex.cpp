@@ -0,0 +1,337 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTBehaviorTreeIndex.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "DBTAssetRegistryTags.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+#include "Engine/Engine.h"
+
+FDBTBehaviorTreeIndexLoader* FDBTBehaviorTreeIndexLoader::Instance = nullptr;
+
+static void CollectIndexEntries(const UBTCompositeNode* Composite, FDBTBehaviorTreeIndex& Index)
+{
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+    UBTCompositeNode* MutableComposite = const_cast<UBTCompositeNode*>(Composite);
+
+    if (DataManager.HasLimitChangeForNode(MutableComposite))
+    {
+        Index.LimitChanges.Emplace(Composite->GetFName(), DataManager.GetLimitChangeForNode(MutableComposite));
+    }
+
+    for (const FBTCompositeChild& Child : Composite->Children)
+    {
+        if (Child.ChildComposite)
+        {
+            CollectIndexEntries(Child.ChildComposite, Index);
+        }
+        else if (Child.ChildTask && DataManager.GetTaskNodeIsDynamic(Child.ChildTask))
+        {
+            FDBTBehaviorTreeIndex::FTaskEntry& Entry = Index.DynamicTasks.AddDefaulted_GetRef();
+            Entry.NodeName = Child.ChildTask->GetFName();
+            Entry.Category = DataManager.GetTaskNodeCategory(Child.ChildTask);
+        }
+    }
+}
+
+static void CollectNodesByName(UBTCompositeNode* Composite, TMap<FName, UBTNode*>& OutNodes)
+{
+    OutNodes.Add(Composite->GetFName(), Composite);
+
+    for (const FBTCompositeChild& Child : Composite->Children)
+    {
+        if (Child.ChildComposite)
+        {
+            CollectNodesByName(Child.ChildComposite, OutNodes);
+        }
+        else if (Child.ChildTask)
+        {
+            OutNodes.Add(Child.ChildTask->GetFName(), Child.ChildTask);
+        }
+    }
+}
+
+FDBTBehaviorTreeIndex FDBTBehaviorTreeIndex::FromBehaviorTree(const UBehaviorTree* BehaviorTree)
+{
+    FDBTBehaviorTreeIndex Index;
+    if (BehaviorTree)
+    {
+        Index.TreePath = FSoftObjectPath(BehaviorTree);
+        if (BehaviorTree->RootNode)
+        {
+            CollectIndexEntries(BehaviorTree->RootNode, Index);
+        }
+    }
+    return Index;
+}
+
+FDBTBehaviorTreeIndex FDBTBehaviorTreeIndex::FromAssetData(const FAssetData& AssetData)
+{
+    FDBTBehaviorTreeIndex Index;
+    Index.TreePath = AssetData.ToSoftObjectPath();
+
+    TArray<FDBTTaggedEntry> Entries;
+    FDBTAssetRegistryTags::ReadEntries(AssetData, FDBTAssetRegistryTags::DynamicTasksTag, Entries);
+    for (const FDBTTaggedEntry& Entry : Entries)
+    {
+        FTaskEntry& Task = Index.DynamicTasks.AddDefaulted_GetRef();
+        Task.NodeName = FName(*Entry.Name);
+        Task.Category = Entry.Value;
+    }
+
+    Entries.Reset();
+    FDBTAssetRegistryTags::ReadEntries(AssetData, FDBTAssetRegistryTags::LimitChangesTag, Entries);
+    for (const FDBTTaggedEntry& Entry : Entries)
+    {
+        Index.LimitChanges.Emplace(FName(*Entry.Name), FCString::Atoi(*Entry.Value));
+    }
+
+    return Index;
+}
+
+FString FDBTBehaviorTreeIndex::GetIndexFilePath(const FSoftObjectPath& TreePath, const FString& IndexDirectory)
+{
+    const FString Directory = IndexDirectory.IsEmpty() ? FPaths::ProjectConfigDir() / TEXT("DBTIndex") : IndexDirectory;
+
+    // "/Game/AI/BT_Enemy" -> "<Directory>/Game/AI/BT_Enemy.bin"
+    return Directory / TreePath.GetLongPackageName().RightChop(1) + TEXT(".bin");
+}
+
+bool FDBTBehaviorTreeIndex::SaveToFile(const FString& FilePath) const
+{
+    FBufferArchive Writer;
+
+    uint32 Magic = FileMagic;
+    uint16 Version = FileVersion;
+    FString Path = TreePath.ToString();
+    int32 NumTasks = DynamicTasks.Num();
+    int32 NumLimits = LimitChanges.Num();
+    Writer << Magic << Version << Path << NumTasks << NumLimits;
+
+    for (const FTaskEntry& Entry : DynamicTasks)
+    {
+        FString NodeName = Entry.NodeName.ToString();
+        FString Category = Entry.Category;
+        Writer << NodeName << Category;
+    }
+
+    for (const TPair<FName, int32>& Limit : LimitChanges)
+    {
+        FString NodeName = Limit.Key.ToString();
+        int32 Value = Limit.Value;
+        Writer << NodeName << Value;
+    }
+
+    return FFileHelper::SaveArrayToFile(Writer, *FilePath);
+}
+
+bool FDBTBehaviorTreeIndex::LoadFromFile(const FString& FilePath)
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *FilePath, FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Data);
+
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    FString Path;
+    int32 NumTasks = 0;
+    int32 NumLimits = 0;
+    Reader << Magic << Version << Path << NumTasks << NumLimits;
+
+    if (Magic != FileMagic || Version != FileVersion || NumTasks < 0 || NumLimits < 0)
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTBehaviorTreeIndex: %s is not a version %d index"), *FilePath, FileVersion);
+        return false;
+    }
+
+    TreePath = FSoftObjectPath(Path);
+    DynamicTasks.Reset(NumTasks);
+    LimitChanges.Reset(NumLimits);
+
+    for (int32 i = 0; i < NumTasks && !Reader.IsError(); i++)
+    {
+        FString NodeName;
+        FTaskEntry& Entry = DynamicTasks.AddDefaulted_GetRef();
+        Reader << NodeName << Entry.Category;
+        Entry.NodeName = FName(*NodeName);
+    }
+
+    for (int32 i = 0; i < NumLimits && !Reader.IsError(); i++)
+    {
+        FString NodeName;
+        int32 Value = 0;
+        Reader << NodeName << Value;
+        LimitChanges.Emplace(FName(*NodeName), Value);
+    }
+
+    return !Reader.IsError();
+}
+
+bool FDBTBehaviorTreeIndex::HasSameEntries(const FDBTBehaviorTreeIndex& Other) const
+{
+    if (DynamicTasks.Num() != Other.DynamicTasks.Num() || LimitChanges.Num() != Other.LimitChanges.Num())
+    {
+        return false;
+    }
+
+    TMap<FName, FString> Categories;
+    for (const FTaskEntry& Entry : DynamicTasks)
+    {
+        Categories.Add(Entry.NodeName, Entry.Category);
+    }
+    for (const FTaskEntry& Entry : Other.DynamicTasks)
+    {
+        const FString* Category = Categories.Find(Entry.NodeName);
+        if (!Category || *Category != Entry.Category)
+        {
+            return false;
+        }
+    }
+
+    TMap<FName, int32> Limits;
+    for (const TPair<FName, int32>& Limit : LimitChanges)
+    {
+        Limits.Add(Limit.Key, Limit.Value);
+    }
+    for (const TPair<FName, int32>& Limit : Other.LimitChanges)
+    {
+        const int32* Value = Limits.Find(Limit.Key);
+        if (!Value || *Value != Limit.Value)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int32 FDBTBehaviorTreeIndex::ApplyToBehaviorTree(UBehaviorTree* BehaviorTree, TArray<FName>* OutUnresolvedNodes) const
+{
+    if (!BehaviorTree || !BehaviorTree->RootNode)
+    {
+        return 0;
+    }
+
+    TMap<FName, UBTNode*> Nodes;
+    CollectNodesByName(BehaviorTree->RootNode, Nodes);
+
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+    int32 NumApplied = 0;
+
+    for (const FTaskEntry& Entry : DynamicTasks)
+    {
+        UBTNode* const* Node = Nodes.Find(Entry.NodeName);
+        if (!Node || !Cast<UBTTaskNode>(*Node))
+        {
+            if (OutUnresolvedNodes)
+            {
+                OutUnresolvedNodes->Add(Entry.NodeName);
+            }
+            continue;
+        }
+
+        if (!DataManager.GetTaskNodeIsDynamic(*Node))
+        {
+            DataManager.SetTaskNodeDynamicData(*Node, true, Entry.Category);
+            NumApplied++;
+        }
+    }
+
+    for (const TPair<FName, int32>& Limit : LimitChanges)
+    {
+        UBTNode* const* Node = Nodes.Find(Limit.Key);
+        if (!Node || !Cast<UBTCompositeNode>(*Node))
+        {
+            if (OutUnresolvedNodes)
+            {
+                OutUnresolvedNodes->Add(Limit.Key);
+            }
+            continue;
+        }
+
+        if (!DataManager.HasLimitChangeForNode(*Node))
+        {
+            DataManager.SetLimitChangeForNode(*Node, Limit.Value);
+            NumApplied++;
+        }
+    }
+
+    return NumApplied;
+}
+
+#if WITH_EDITOR
+void FDBTBehaviorTreeIndex::WriteForSavedPackage(const FString& PackageFileName, UObject* PackageObject)
+{
+    UPackage* Package = Cast<UPackage>(PackageObject);
+    if (!Package || IsRunningCookCommandlet())
+    {
+        return;
+    }
+
+    const UBehaviorTree* BehaviorTree = FindObject<UBehaviorTree>(Package, *FPackageName::GetShortName(Package));
+    if (!BehaviorTree)
+    {
+        return;
+    }
+
+    const FDBTBehaviorTreeIndex Index = FromBehaviorTree(BehaviorTree);
+    const FString FilePath = GetIndexFilePath(Index.TreePath);
+
+    if (Index.IsEmpty())
+    {
+        IFileManager::Get().Delete(*FilePath, false, false, true);
+    }
+    else if (!Index.SaveToFile(FilePath))
+    {
+        GLog->Logf(ELogVerbosity::Error, TEXT("DBTBehaviorTreeIndex: Could not write %s"), *FilePath);
+    }
+}
+#endif
+
+FDBTBehaviorTreeIndexLoader& FDBTBehaviorTreeIndexLoader::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FDBTBehaviorTreeIndexLoader();
+    }
+    return *Instance;
+}
+
+void FDBTBehaviorTreeIndexLoader::Release()
+{
+    delete Instance;
+    Instance = nullptr;
+}
+
+void FDBTBehaviorTreeIndexLoader::EnsureApplied(UBehaviorTree* BehaviorTree)
+{
+    if (!BehaviorTree || GIsEditor)
+    {
+        return;
+    }
+
+    bool bAlreadyVisited = false;
+    VisitedTrees.Add(FObjectKey(BehaviorTree), &bAlreadyVisited);
+    if (bAlreadyVisited)
+    {
+        return;
+    }
+
+    FDBTBehaviorTreeIndex Index;
+    if (Index.LoadFromFile(FDBTBehaviorTreeIndex::GetIndexFilePath(FSoftObjectPath(BehaviorTree))))
+    {
+        const int32 NumApplied = Index.ApplyToBehaviorTree(BehaviorTree);
+        GLog->Logf(ELogVerbosity::Display, TEXT("DBTBehaviorTreeIndex: Applied %d baked entries to %s"), NumApplied, *BehaviorTree->GetName());
+    }
+}
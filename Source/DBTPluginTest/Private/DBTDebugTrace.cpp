@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTDebugTrace.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarDBTDebugTrace(
+    TEXT("dbt.Debug.Trace"),
+    1,
+    TEXT("Record limit checks and priority swaps into the debug ring buffer read by the DynamicBehavior gameplay debugger category (0 = off, 1 = on)."));
+
+static TAutoConsoleVariable<int32> CVarDBTDebugTraceLimitCheckRate(
+    TEXT("dbt.Debug.TraceLimitCheckRate"),
+    4,
+    TEXT("Record one limit check out of every N. Swaps are always recorded."));
+
+FDBTDebugTrace* FDBTDebugTrace::Instance = nullptr;
+
+FDBTDebugTrace& FDBTDebugTrace::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FDBTDebugTrace();
+    }
+    return *Instance;
+}
+
+void FDBTDebugTrace::Release()
+{
+    delete Instance;
+    Instance = nullptr;
+}
+
+bool FDBTDebugTrace::IsEnabled()
+{
+    return CVarDBTDebugTrace.GetValueOnGameThread() != 0;
+}
+
+FDBTDebugTrace::FDBTDebugTrace()
+{
+    Ring.SetNum(Capacity);
+}
+
+void FDBTDebugTrace::RecordLimitCheck(const UBehaviorTreeComponent* Owner, const UBTCompositeNode* Composite, int32 LimitChange, int32 UsageCount)
+{
+    const uint32 Rate = (uint32)FMath::Max(1, CVarDBTDebugTraceLimitCheckRate.GetValueOnGameThread());
+    if (LimitCheckCounter++ % Rate == 0)
+    {
+        Push(EDBTDebugSampleType::LimitCheck, Owner, Composite, LimitChange, UsageCount);
+    }
+}
+
+void FDBTDebugTrace::RecordSwap(const UBehaviorTreeComponent* Owner, const UBTCompositeNode* Composite, int32 FirstIndex, int32 SecondIndex)
+{
+    Push(EDBTDebugSampleType::Swap, Owner, Composite, FirstIndex, SecondIndex);
+}
+
+void FDBTDebugTrace::Push(EDBTDebugSampleType Type, const UBehaviorTreeComponent* Owner, const UBTCompositeNode* Composite, int32 ValueA, int32 ValueB)
+{
+    FDBTDebugSample& Sample = Ring[Written % Capacity];
+    Sample.Type = Type;
+    Sample.Composite = FObjectKey(Composite);
+    Sample.Owner = FObjectKey(Owner);
+
+    const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+    Sample.Time = World ? World->GetTimeSeconds() : 0.0;
+    Sample.ValueA = ValueA;
+    Sample.ValueB = ValueB;
+    Written++;
+}
+
+uint64 FDBTDebugTrace::ReadSince(uint64 Cursor, TArray<FDBTDebugSample>& OutSamples) const
+{
+    const uint64 First = FMath::Max(Cursor, Written > Capacity ? Written - Capacity : 0);
+    for (uint64 Index = First; Index < Written; Index++)
+    {
+        OutSamples.Add(Ring[Index % Capacity]);
+    }
+    return Written;
+}
@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTMaxAttributeAdjuster.h"
+#include "DBTMaxValuesConfig.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayEffect.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/Engine.h"
+
+const FName FDBTMaxAttributeAdjuster::CoefficientName(TEXT("DBTMaxCoefficient"));
+
+FDBTMaxAttributeAdjuster* FDBTMaxAttributeAdjuster::Instance = nullptr;
+
+FDBTMaxAttributeAdjuster& FDBTMaxAttributeAdjuster::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FDBTMaxAttributeAdjuster();
+    }
+    return *Instance;
+}
+
+void FDBTMaxAttributeAdjuster::Release()
+{
+    if (Instance)
+    {
+        delete Instance;
+        Instance = nullptr;
+    }
+}
+
+FDBTMaxAttributeAdjuster::FDBTMaxAttributeAdjuster()
+{
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FDBTMaxAttributeAdjuster::PruneCollectedClasses);
+}
+
+FDBTMaxAttributeAdjuster::~FDBTMaxAttributeAdjuster()
+{
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+}
+
+void FDBTMaxAttributeAdjuster::Invalidate()
+{
+    Layouts.Empty();
+}
+
+void FDBTMaxAttributeAdjuster::PruneCollectedClasses()
+{
+    for (auto It = Layouts.CreateIterator(); It; ++It)
+    {
+        for (const TWeakObjectPtr<UClass>& Class : It.Value().Classes)
+        {
+            if (!Class.IsValid())
+            {
+                It.RemoveCurrent();
+                break;
+            }
+        }
+    }
+}
+
+FDBTMaxAttributeLayoutRef FDBTMaxAttributeAdjuster::GetLayout(const UAbilitySystemComponent& AbilitySystem)
+{
+    TArray<UClass*> AttributeSetClasses;
+    uint32 Hash = 0;
+    for (const UAttributeSet* AttributeSet : AbilitySystem.GetSpawnedAttributes())
+    {
+        if (AttributeSet)
+        {
+            AttributeSetClasses.Add(AttributeSet->GetClass());
+            Hash = HashCombine(Hash, PointerHash(AttributeSet->GetClass()));
+        }
+    }
+
+    TArray<FCachedLayout*, TInlineAllocator<2>> Candidates;
+    Layouts.MultiFindPointer(Hash, Candidates);
+    for (FCachedLayout* Candidate : Candidates)
+    {
+        bool bMatches = Candidate->Classes.Num() == AttributeSetClasses.Num();
+        for (int32 i = 0; bMatches && i < AttributeSetClasses.Num(); i++)
+        {
+            bMatches = Candidate->Classes[i].Get() == AttributeSetClasses[i];
+        }
+
+        if (bMatches)
+        {
+            return Candidate->Layout;
+        }
+    }
+
+    FDBTMaxAttributeLayoutRef Layout = BuildLayout(AttributeSetClasses);
+
+    FCachedLayout& Cached = Layouts.Add(Hash, FCachedLayout{ {}, Layout });
+    for (UClass* AttributeSetClass : AttributeSetClasses)
+    {
+        Cached.Classes.Add(AttributeSetClass);
+    }
+
+    return Layout;
+}
+
+FDBTMaxAttributeLayoutRef FDBTMaxAttributeAdjuster::BuildLayout(const TArray<UClass*>& AttributeSetClasses)
+{
+    TSharedRef<FDBTMaxAttributeLayout, ESPMode::ThreadSafe> Layout = MakeShared<FDBTMaxAttributeLayout, ESPMode::ThreadSafe>();
+
+    FString EffectName = TEXT("GE_DBTMaxAdjustment");
+    for (UClass* AttributeSetClass : AttributeSetClasses)
+    {
+        for (TFieldIterator<FStructProperty> PropIt(AttributeSetClass); PropIt; ++PropIt)
+        {
+            FStructProperty* StructProperty = *PropIt;
+            if (StructProperty->GetName().Contains(TEXT("Max")) && FGameplayAttribute::IsGameplayAttributeDataProperty(StructProperty))
+            {
+                Layout->Attributes.Add(FGameplayAttribute(StructProperty));
+            }
+        }
+
+        EffectName += TEXT("_") + AttributeSetClass->GetName();
+    }
+
+    if (Layout->Attributes.Num() > 0)
+    {
+        UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UGameplayEffect::StaticClass(), FName(*EffectName)), RF_Transient);
+        Effect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+        FSetByCallerFloat SetByCaller;
+        SetByCaller.DataName = CoefficientName;
+
+        for (const FGameplayAttribute& Attribute : Layout->Attributes)
+        {
+            FGameplayModifierInfo& Modifier = Effect->Modifiers.AddDefaulted_GetRef();
+            Modifier.Attribute = Attribute;
+            Modifier.ModifierOp = EGameplayModOp::Multiplicitive;
+            Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+        }
+
+        Layout->Effect.Reset(Effect);
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("DBTMaxAttributeAdjuster: Cached %d MAX attributes for %s"), Layout->Attributes.Num(), *EffectName);
+
+    return Layout;
+}
+
+UAbilitySystemComponent* FDBTMaxAttributeAdjuster::FindMaxAttributes(AActor* Actor, TSharedPtr<const FDBTMaxAttributeLayout, ESPMode::ThreadSafe>& OutLayout)
+{
+    UAbilitySystemComponent* AbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor);
+    if (!AbilitySystem)
+    {
+        return nullptr;
+    }
+
+    FDBTMaxAttributeLayoutRef Layout = GetLayout(*AbilitySystem);
+    if (Layout->Attributes.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    OutLayout = Layout;
+    return AbilitySystem;
+}
+
+void FDBTMaxAttributeAdjuster::ApplyCoefficient(UAbilitySystemComponent& AbilitySystem, const FDBTMaxAttributeLayout& Layout, double Coefficient)
+{
+    if (Coefficient == 1.0 || !AbilitySystem.IsOwnerActorAuthoritative())
+    {
+        return;
+    }
+
+    FGameplayEffectSpec Spec(Layout.Effect.Get(), AbilitySystem.MakeEffectContext(), 1.0f);
+    Spec.SetSetByCallerMagnitude(CoefficientName, (float)Coefficient);
+    AbilitySystem.ApplyGameplayEffectSpecToSelf(Spec);
+}
+
+bool FDBTMaxAttributeAdjuster::AdjustActor(AActor* Actor, const FDBTMaxValuesTable& Config)
+{
+    TSharedPtr<const FDBTMaxAttributeLayout, ESPMode::ThreadSafe> Layout;
+    UAbilitySystemComponent* AbilitySystem = FindMaxAttributes(Actor, Layout);
+    if (!AbilitySystem)
+    {
+        return false;
+    }
+
+    // Clients get the result through attribute replication
+    if (!AbilitySystem->IsOwnerActorAuthoritative())
+    {
+        return true;
+    }
+
+    double SumDifferences = 0.0;
+    int32 ValidAttributesCount = 0;
+
+    for (const FGameplayAttribute& Attribute : Layout->Attributes)
+    {
+        const double FileValue = Config.GetValue(FName(*Attribute.GetName()));
+        if (FileValue != 0.0)
+        {
+            SumDifferences += FMath::Abs(AbilitySystem->GetNumericAttributeBase(Attribute) - FileValue);
+            ValidAttributesCount++;
+        }
+    }
+
+    double Coefficient = 1.0;
+    if (ValidAttributesCount > 0 && SumDifferences > 0.0)
+    {
+        Coefficient = SumDifferences / ValidAttributesCount;
+    }
+
+    ApplyCoefficient(*AbilitySystem, *Layout, Coefficient);
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("AdjustMaxPropertiesFromConfig: %s: %d MAX attributes adjusted by coefficient %f (%d valid for calculation)"),
+        *Actor->GetName(), Layout->Attributes.Num(), Coefficient, ValidAttributesCount);
+
+    return true;
+}
@@ -0,0 +1,215 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTMaxPropertiesBatch.h"
+#include "DBTMaxValuesConfig.h"
+#include "GameFramework/Character.h"
+#include "Engine/Engine.h"
+#include "Async/ParallelFor.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && (PLATFORM_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define DBT_BATCH_SSE2 1
+#else
+#define DBT_BATCH_SSE2 0
+#endif
+
+namespace DBTBatchKernels
+{
+    // Sums[i] += |Column[i] - FileValue|
+    static void AccumulateAbsDifference(const double* RESTRICT Column, double FileValue, double* RESTRICT Sums, int32 Count)
+    {
+        int32 i = 0;
+#if DBT_BATCH_SSE2
+        const __m128d File = _mm_set1_pd(FileValue);
+        const __m128d SignMask = _mm_set1_pd(-0.0);
+        for (; i + 2 <= Count; i += 2)
+        {
+            const __m128d Difference = _mm_andnot_pd(SignMask, _mm_sub_pd(_mm_loadu_pd(Column + i), File));
+            _mm_storeu_pd(Sums + i, _mm_add_pd(_mm_loadu_pd(Sums + i), Difference));
+        }
+#endif
+        for (; i < Count; i++)
+        {
+            Sums[i] += FMath::Abs(Column[i] - FileValue);
+        }
+    }
+
+    // Coefficients[i] = Sums[i] > 0 ? Sums[i] / ValidCount : 1
+    static void ComputeCoefficients(const double* RESTRICT Sums, int32 ValidCount, double* RESTRICT Coefficients, int32 Count)
+    {
+        if (ValidCount <= 0)
+        {
+            for (int32 i = 0; i < Count; i++)
+            {
+                Coefficients[i] = 1.0;
+            }
+            return;
+        }
+
+        const double InvValidCount = 1.0 / ValidCount;
+        int32 i = 0;
+#if DBT_BATCH_SSE2
+        const __m128d Zero = _mm_setzero_pd();
+        const __m128d One = _mm_set1_pd(1.0);
+        const __m128d Scale = _mm_set1_pd(InvValidCount);
+        for (; i + 2 <= Count; i += 2)
+        {
+            const __m128d Sum = _mm_loadu_pd(Sums + i);
+            const __m128d Mask = _mm_cmpgt_pd(Sum, Zero);
+            const __m128d Result = _mm_or_pd(_mm_and_pd(Mask, _mm_mul_pd(Sum, Scale)), _mm_andnot_pd(Mask, One));
+            _mm_storeu_pd(Coefficients + i, Result);
+        }
+#endif
+        for (; i < Count; i++)
+        {
+            Coefficients[i] = Sums[i] > 0.0 ? Sums[i] * InvValidCount : 1.0;
+        }
+    }
+
+    // Column[i] *= Coefficients[i]
+    static void Scale(double* RESTRICT Column, const double* RESTRICT Coefficients, int32 Count)
+    {
+        int32 i = 0;
+#if DBT_BATCH_SSE2
+        for (; i + 2 <= Count; i += 2)
+        {
+            _mm_storeu_pd(Column + i, _mm_mul_pd(_mm_loadu_pd(Column + i), _mm_loadu_pd(Coefficients + i)));
+        }
+#endif
+        for (; i < Count; i++)
+        {
+            Column[i] *= Coefficients[i];
+        }
+    }
+}
+
+void FDBTMaxPropertiesBatch::BuildBatches(const TArray<ACharacter*>& Characters, TArray<FDBTAdjustmentBatch>& OutBatches, int32 MaxBatchSize)
+{
+    FDBTMaxPropertyLayoutCache& LayoutCache = FDBTMaxPropertyLayoutCache::Get();
+    TMap<const FDBTMaxPropertyLayout*, int32> BatchIndexByLayout;
+
+    for (ACharacter* Character : Characters)
+    {
+        if (!Character)
+        {
+            continue;
+        }
+
+        FDBTMaxPropertyLayoutRef Layout = LayoutCache.GetLayout(Character->GetClass());
+        if (Layout->Properties.Num() == 0)
+        {
+            continue;
+        }
+
+        int32* BatchIndex = BatchIndexByLayout.Find(&Layout.Get());
+        if (!BatchIndex || OutBatches[*BatchIndex].Characters.Num() >= MaxBatchSize)
+        {
+            // Full batches stay in OutBatches, the layout now points at a fresh one
+            BatchIndex = &BatchIndexByLayout.Add(&Layout.Get(), OutBatches.Emplace(Layout));
+        }
+
+        OutBatches[*BatchIndex].Characters.Add(Character);
+    }
+}
+
+void FDBTMaxPropertiesBatch::Gather(FDBTAdjustmentBatch& Batch, const FDBTMaxValuesTable& Config)
+{
+    const TArray<FDBTMaxPropertyEntry>& Properties = Batch.Layout->Properties;
+    const int32 NumCharacters = Batch.Characters.Num();
+
+    Batch.FileValues.SetNumUninitialized(Properties.Num());
+    Batch.ValidPropertiesCount = 0;
+    for (int32 PropertyIndex = 0; PropertyIndex < Properties.Num(); PropertyIndex++)
+    {
+        Batch.FileValues[PropertyIndex] = Config.GetValue(Properties[PropertyIndex].Name);
+        if (Batch.FileValues[PropertyIndex] != 0.0)
+        {
+            Batch.ValidPropertiesCount++;
+        }
+    }
+
+    Batch.Values.SetNumUninitialized(Properties.Num() * NumCharacters);
+    for (int32 PropertyIndex = 0; PropertyIndex < Properties.Num(); PropertyIndex++)
+    {
+        double* Column = Batch.GetColumn(PropertyIndex);
+        const FDBTMaxPropertyEntry& Entry = Properties[PropertyIndex];
+        for (int32 CharacterIndex = 0; CharacterIndex < NumCharacters; CharacterIndex++)
+        {
+            Column[CharacterIndex] = FDBTMaxPropertyLayout::ReadValue(Batch.Characters[CharacterIndex], Entry);
+        }
+    }
+}
+
+void FDBTMaxPropertiesBatch::ComputeCoefficients(FDBTAdjustmentBatch& Batch)
+{
+    const int32 NumCharacters = Batch.Characters.Num();
+
+    TArray<double> SumDifferences;
+    SumDifferences.SetNumZeroed(NumCharacters);
+
+    for (int32 PropertyIndex = 0; PropertyIndex < Batch.FileValues.Num(); PropertyIndex++)
+    {
+        if (Batch.FileValues[PropertyIndex] != 0.0)
+        {
+            DBTBatchKernels::AccumulateAbsDifference(Batch.GetColumn(PropertyIndex), Batch.FileValues[PropertyIndex], SumDifferences.GetData(), NumCharacters);
+        }
+    }
+
+    Batch.Coefficients.SetNumUninitialized(NumCharacters);
+    DBTBatchKernels::ComputeCoefficients(SumDifferences.GetData(), Batch.ValidPropertiesCount, Batch.Coefficients.GetData(), NumCharacters);
+}
+
+void FDBTMaxPropertiesBatch::ApplyCoefficients(FDBTAdjustmentBatch& Batch)
+{
+    for (int32 PropertyIndex = 0; PropertyIndex < Batch.FileValues.Num(); PropertyIndex++)
+    {
+        DBTBatchKernels::Scale(Batch.GetColumn(PropertyIndex), Batch.Coefficients.GetData(), Batch.Characters.Num());
+    }
+}
+
+void FDBTMaxPropertiesBatch::ComputeBatches(TArray<FDBTAdjustmentBatch>& Batches, const FDBTMaxValuesTable& Config)
+{
+    ParallelFor(Batches.Num(), [&Batches, &Config](int32 BatchIndex)
+    {
+        FDBTAdjustmentBatch& Batch = Batches[BatchIndex];
+        Gather(Batch, Config);
+        ComputeCoefficients(Batch);
+        ApplyCoefficients(Batch);
+    });
+}
+
+void FDBTMaxPropertiesBatch::Scatter(const FDBTAdjustmentBatch& Batch)
+{
+    const TArray<FDBTMaxPropertyEntry>& Properties = Batch.Layout->Properties;
+    const int32 NumCharacters = Batch.Characters.Num();
+
+    for (int32 PropertyIndex = 0; PropertyIndex < Properties.Num(); PropertyIndex++)
+    {
+        const double* Column = Batch.GetColumn(PropertyIndex);
+        const FDBTMaxPropertyEntry& Entry = Properties[PropertyIndex];
+        for (int32 CharacterIndex = 0; CharacterIndex < NumCharacters; CharacterIndex++)
+        {
+            FDBTMaxPropertyLayout::WriteValue(Batch.Characters[CharacterIndex], Entry, Column[CharacterIndex]);
+        }
+    }
+}
+
+int32 FDBTMaxPropertiesBatch::AdjustCharacters(const TArray<ACharacter*>& Characters, const FDBTMaxValuesTable& Config)
+{
+    TArray<FDBTAdjustmentBatch> Batches;
+    BuildBatches(Characters, Batches);
+    ComputeBatches(Batches, Config);
+
+    int32 AdjustedCount = 0;
+    for (const FDBTAdjustmentBatch& Batch : Batches)
+    {
+        Scatter(Batch);
+
+        AdjustedCount += Batch.Characters.Num();
+
+        GLog->Logf(ELogVerbosity::Display, TEXT("AdjustMaxPropertiesFromConfig: Batch of %d character(s) with %d MAX properties adjusted (%d valid for calculation)"),
+            Batch.Characters.Num(), Batch.Layout->Properties.Num(), Batch.ValidPropertiesCount);
+    }
+
+    return AdjustedCount;
+}
@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTMaxPropertyLayout.h"
+#include "GameFramework/Character.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/Engine.h"
+
+double FDBTMaxPropertyLayout::ReadValue(const void* Container, const FDBTMaxPropertyEntry& Entry)
+{
+    const uint8* ValuePtr = static_cast<const uint8*>(Container) + Entry.Offset;
+
+    switch (Entry.Kind)
+    {
+    case EDBTNumericKind::Float:  return *reinterpret_cast<const float*>(ValuePtr);
+    case EDBTNumericKind::Double: return *reinterpret_cast<const double*>(ValuePtr);
+    case EDBTNumericKind::Int8:   return *reinterpret_cast<const int8*>(ValuePtr);
+    case EDBTNumericKind::Int16:  return *reinterpret_cast<const int16*>(ValuePtr);
+    case EDBTNumericKind::Int32:  return *reinterpret_cast<const int32*>(ValuePtr);
+    case EDBTNumericKind::Int64:  return (double)*reinterpret_cast<const int64*>(ValuePtr);
+    case EDBTNumericKind::UInt8:  return *reinterpret_cast<const uint8*>(ValuePtr);
+    case EDBTNumericKind::UInt16: return *reinterpret_cast<const uint16*>(ValuePtr);
+    case EDBTNumericKind::UInt32: return *reinterpret_cast<const uint32*>(ValuePtr);
+    case EDBTNumericKind::UInt64: return (double)*reinterpret_cast<const uint64*>(ValuePtr);
+    default:                      return 0.0;
+    }
+}
+
+void FDBTMaxPropertyLayout::WriteValue(void* Container, const FDBTMaxPropertyEntry& Entry, double Value)
+{
+    uint8* ValuePtr = static_cast<uint8*>(Container) + Entry.Offset;
+    const int64 IntValue = (int64)FMath::RoundToDouble(Value);
+
+    switch (Entry.Kind)
+    {
+    case EDBTNumericKind::Float:  *reinterpret_cast<float*>(ValuePtr) = (float)Value; break;
+    case EDBTNumericKind::Double: *reinterpret_cast<double*>(ValuePtr) = Value; break;
+    case EDBTNumericKind::Int8:   *reinterpret_cast<int8*>(ValuePtr) = (int8)IntValue; break;
+    case EDBTNumericKind::Int16:  *reinterpret_cast<int16*>(ValuePtr) = (int16)IntValue; break;
+    case EDBTNumericKind::Int32:  *reinterpret_cast<int32*>(ValuePtr) = (int32)IntValue; break;
+    case EDBTNumericKind::Int64:  *reinterpret_cast<int64*>(ValuePtr) = IntValue; break;
+    case EDBTNumericKind::UInt8:  *reinterpret_cast<uint8*>(ValuePtr) = (uint8)IntValue; break;
+    case EDBTNumericKind::UInt16: *reinterpret_cast<uint16*>(ValuePtr) = (uint16)IntValue; break;
+    case EDBTNumericKind::UInt32: *reinterpret_cast<uint32*>(ValuePtr) = (uint32)IntValue; break;
+    case EDBTNumericKind::UInt64: *reinterpret_cast<uint64*>(ValuePtr) = (uint64)IntValue; break;
+    default: break;
+    }
+}
+
+FDBTMaxPropertyLayoutCache* FDBTMaxPropertyLayoutCache::Instance = nullptr;
+
+FDBTMaxPropertyLayoutCache& FDBTMaxPropertyLayoutCache::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FDBTMaxPropertyLayoutCache();
+    }
+    return *Instance;
+}
+
+void FDBTMaxPropertyLayoutCache::Release()
+{
+    if (Instance)
+    {
+        delete Instance;
+        Instance = nullptr;
+    }
+}
+
+FDBTMaxPropertyLayoutCache::FDBTMaxPropertyLayoutCache()
+{
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FDBTMaxPropertyLayoutCache::PruneCollectedClasses);
+
+#if WITH_EDITOR
+    ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([this](const TMap<UObject*, UObject*>& ReplacementMap)
+    {
+        Invalidate();
+    });
+#endif
+}
+
+FDBTMaxPropertyLayoutCache::~FDBTMaxPropertyLayoutCache()
+{
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+#if WITH_EDITOR
+    FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+#endif
+}
+
+FDBTMaxPropertyLayoutRef FDBTMaxPropertyLayoutCache::GetLayout(UClass* CharacterClass)
+{
+    const FObjectKey ClassKey(CharacterClass);
+    if (const FCachedLayout* Cached = Layouts.Find(ClassKey))
+    {
+        return Cached->Layout;
+    }
+
+    FDBTMaxPropertyLayoutRef Layout = BuildLayout(CharacterClass);
+    Layouts.Add(ClassKey, FCachedLayout{ CharacterClass, Layout });
+    return Layout;
+}
+
+void FDBTMaxPropertyLayoutCache::Invalidate()
+{
+    Layouts.Empty();
+}
+
+void FDBTMaxPropertyLayoutCache::PruneCollectedClasses()
+{
+    for (auto It = Layouts.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().Class.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+FDBTMaxPropertyLayoutRef FDBTMaxPropertyLayoutCache::BuildLayout(UClass* CharacterClass)
+{
+    TSharedRef<FDBTMaxPropertyLayout, ESPMode::ThreadSafe> Layout = MakeShared<FDBTMaxPropertyLayout, ESPMode::ThreadSafe>();
+    TSet<FName> AddedNames;
+
+    for (UClass* CurrentClass = CharacterClass; CurrentClass; CurrentClass = CurrentClass->GetSuperClass())
+    {
+        for (TFieldIterator<FNumericProperty> PropIt(CurrentClass, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
+        {
+            FNumericProperty* NumericProperty = *PropIt;
+            if (!NumericProperty->GetName().Contains(TEXT("Max")) || AddedNames.Contains(NumericProperty->GetFName()))
+            {
+                continue;
+            }
+
+            FDBTMaxPropertyEntry Entry;
+            Entry.Name = NumericProperty->GetFName();
+            Entry.DeclaringClassName = CurrentClass->GetFName();
+            Entry.Offset = NumericProperty->GetOffset_ForInternal();
+
+            if (NumericProperty->IsA<FFloatProperty>())        Entry.Kind = EDBTNumericKind::Float;
+            else if (NumericProperty->IsA<FDoubleProperty>())  Entry.Kind = EDBTNumericKind::Double;
+            else if (NumericProperty->IsA<FInt8Property>())    Entry.Kind = EDBTNumericKind::Int8;
+            else if (NumericProperty->IsA<FInt16Property>())   Entry.Kind = EDBTNumericKind::Int16;
+            else if (NumericProperty->IsA<FIntProperty>())     Entry.Kind = EDBTNumericKind::Int32;
+            else if (NumericProperty->IsA<FInt64Property>())   Entry.Kind = EDBTNumericKind::Int64;
+            else if (NumericProperty->IsA<FByteProperty>())    Entry.Kind = EDBTNumericKind::UInt8;
+            else if (NumericProperty->IsA<FUInt16Property>())  Entry.Kind = EDBTNumericKind::UInt16;
+            else if (NumericProperty->IsA<FUInt32Property>())  Entry.Kind = EDBTNumericKind::UInt32;
+            else if (NumericProperty->IsA<FUInt64Property>())  Entry.Kind = EDBTNumericKind::UInt64;
+            else continue;
+
+            AddedNames.Add(Entry.Name);
+            Layout->Properties.Add(Entry);
+        }
+
+        if (CurrentClass == ACharacter::StaticClass())
+        {
+            break;
+        }
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("DBTMaxPropertyLayoutCache: Cached %d MAX properties for class %s"), Layout->Properties.Num(), *CharacterClass->GetName());
+
+    return Layout;
+}
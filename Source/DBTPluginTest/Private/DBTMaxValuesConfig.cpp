@@ -0,0 +1,307 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTMaxValuesConfig.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Engine/Engine.h"
+
+static TAutoConsoleVariable<float> CVarDBTConfigPollInterval(
+    TEXT("dbt.Adjuster.ConfigPollInterval"),
+    2.0f,
+    TEXT("Seconds between checks of AIControllerMaxValues.json for changes. Read when the config cache is created."));
+
+FDBTMaxValuesConfig* FDBTMaxValuesConfig::Instance = nullptr;
+
+FDBTMaxValuesConfig& FDBTMaxValuesConfig::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FDBTMaxValuesConfig();
+    }
+    return *Instance;
+}
+
+void FDBTMaxValuesConfig::Release()
+{
+    if (Instance)
+    {
+        delete Instance;
+        Instance = nullptr;
+    }
+}
+
+FString FDBTMaxValuesConfig::GetConfigFilePath()
+{
+    return FPaths::ProjectConfigDir() / TEXT("AIControllerMaxValues.json");
+}
+
+FString FDBTMaxValuesConfig::GetBinaryConfigFilePath()
+{
+    return FPaths::ProjectConfigDir() / TEXT("AIControllerMaxValues.bin");
+}
+
+FDateTime FDBTMaxValuesConfig::GetNewestSourceTimestamp()
+{
+    const FDateTime JsonTimestamp = IFileManager::Get().GetTimeStamp(*GetConfigFilePath());
+    const FDateTime BinaryTimestamp = IFileManager::Get().GetTimeStamp(*GetBinaryConfigFilePath());
+    return FMath::Max(JsonTimestamp, BinaryTimestamp);
+}
+
+FDBTMaxValuesConfig::FDBTMaxValuesConfig()
+    : bReloadInFlight(false)
+{
+    const float PollInterval = FMath::Max(0.1f, CVarDBTConfigPollInterval.GetValueOnGameThread());
+    TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FDBTMaxValuesConfig::TickReloadCheck), PollInterval);
+}
+
+FDBTMaxValuesConfig::~FDBTMaxValuesConfig()
+{
+    FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    // A reload task may still hold a pointer to this object
+    while (bReloadInFlight.load())
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+}
+
+FDBTMaxValuesConfig::FTablePtr FDBTMaxValuesConfig::GetTable()
+{
+    {
+        FScopeLock Lock(&TableLock);
+        if (Table.IsValid())
+        {
+            return Table;
+        }
+    }
+
+    FTablePtr LoadedTable = LoadTable();
+    if (LoadedTable.IsValid())
+    {
+        PublishTable(LoadedTable);
+    }
+    return LoadedTable;
+}
+
+void FDBTMaxValuesConfig::RequestReload()
+{
+    StartBackgroundReload(true);
+}
+
+bool FDBTMaxValuesConfig::TickReloadCheck(float DeltaTime)
+{
+    StartBackgroundReload(false);
+    return true;
+}
+
+void FDBTMaxValuesConfig::StartBackgroundReload(bool bForce)
+{
+    bool bExpected = false;
+    if (!bReloadInFlight.compare_exchange_strong(bExpected, true))
+    {
+        return;
+    }
+
+    FDateTime LoadedTimestamp = FDateTime::MinValue();
+    {
+        FScopeLock Lock(&TableLock);
+        if (!Table.IsValid() && !bForce)
+        {
+            // Nobody asked for the config yet, the first GetTable() will load it
+            bReloadInFlight.store(false);
+            return;
+        }
+
+        if (Table.IsValid())
+        {
+            LoadedTimestamp = Table->SourceTimestamp;
+        }
+    }
+
+    Async(EAsyncExecution::ThreadPool, [this, LoadedTimestamp, bForce]()
+    {
+        const FDateTime FileTimestamp = GetNewestSourceTimestamp();
+
+        if (bForce || (FileTimestamp != FDateTime::MinValue() && FileTimestamp != LoadedTimestamp))
+        {
+            FTablePtr NewTable = LoadTable();
+            if (NewTable.IsValid())
+            {
+                PublishTable(NewTable);
+                GLog->Logf(ELogVerbosity::Display, TEXT("DBTMaxValuesConfig: Reloaded config (%d values)"), NewTable->Values.Num());
+            }
+        }
+
+        bReloadInFlight.store(false);
+    });
+}
+
+void FDBTMaxValuesConfig::PublishTable(FTablePtr NewTable)
+{
+    FScopeLock Lock(&TableLock);
+    Table = NewTable;
+}
+
+FDBTMaxValuesConfig::FTablePtr FDBTMaxValuesConfig::LoadTable()
+{
+    const FString JsonFilePath = GetConfigFilePath();
+    const FString BinaryFilePath = GetBinaryConfigFilePath();
+
+    const FDateTime JsonTimestamp = IFileManager::Get().GetTimeStamp(*JsonFilePath);
+    const FDateTime BinaryTimestamp = IFileManager::Get().GetTimeStamp(*BinaryFilePath);
+
+    // A JSON edited after baking wins, otherwise the binary form skips parsing
+    if (BinaryTimestamp != FDateTime::MinValue() && BinaryTimestamp >= JsonTimestamp)
+    {
+        FTablePtr BinaryTable = LoadBinaryTable(BinaryFilePath);
+        if (BinaryTable.IsValid())
+        {
+            return BinaryTable;
+        }
+    }
+
+    FTablePtr JsonTable = LoadJsonTable(JsonFilePath);
+    if (JsonTable.IsValid() && BinaryTimestamp > JsonTimestamp)
+    {
+        // Keep the reload check from seeing the rejected binary as a change every poll
+        TSharedRef<FDBTMaxValuesTable, ESPMode::ThreadSafe> Table = MakeShared<FDBTMaxValuesTable, ESPMode::ThreadSafe>(*JsonTable);
+        Table->SourceTimestamp = BinaryTimestamp;
+        return Table;
+    }
+    return JsonTable;
+}
+
+FDBTMaxValuesConfig::FTablePtr FDBTMaxValuesConfig::LoadBinaryTable(const FString& FilePath)
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+    {
+        return nullptr;
+    }
+
+    FMemoryReader Reader(Data);
+
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    int32 NumValues = 0;
+    Reader << Magic << Version << NumValues;
+
+    if (Magic != BinaryMagic || Version != BinaryVersion || NumValues < 0)
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTMaxValuesConfig: %s is not a version %d binary config, falling back to JSON"), *FilePath, BinaryVersion);
+        return nullptr;
+    }
+
+    TSharedRef<FDBTMaxValuesTable, ESPMode::ThreadSafe> NewTable = MakeShared<FDBTMaxValuesTable, ESPMode::ThreadSafe>();
+    NewTable->SourceTimestamp = IFileManager::Get().GetTimeStamp(*FilePath);
+    NewTable->Values.Reserve(NumValues);
+
+    for (int32 i = 0; i < NumValues && !Reader.IsError(); i++)
+    {
+        FString Name;
+        double Value = 0.0;
+        Reader << Name << Value;
+        NewTable->Values.Add(FName(*Name), Value);
+    }
+
+    if (Reader.IsError())
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTMaxValuesConfig: %s is truncated, falling back to JSON"), *FilePath);
+        return nullptr;
+    }
+
+    return NewTable;
+}
+
+bool FDBTMaxValuesConfig::BakeBinaryConfig(const FString& JsonFilePath, const FString& BinaryFilePath)
+{
+    FTablePtr JsonTable = LoadJsonTable(JsonFilePath);
+    if (!JsonTable.IsValid())
+    {
+        return false;
+    }
+
+    FBufferArchive Writer;
+
+    uint32 Magic = BinaryMagic;
+    uint16 Version = BinaryVersion;
+    int32 NumValues = JsonTable->Values.Num();
+    Writer << Magic << Version << NumValues;
+
+    for (const auto& Pair : JsonTable->Values)
+    {
+        FString Name = Pair.Key.ToString();
+        double Value = Pair.Value;
+        Writer << Name << Value;
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Writer, *BinaryFilePath))
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTMaxValuesConfig: Could not write binary config %s"), *BinaryFilePath);
+        return false;
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("DBTMaxValuesConfig: Baked %d values from %s into %s"), NumValues, *JsonFilePath, *BinaryFilePath);
+    return true;
+}
+
+FDBTMaxValuesConfig::FTablePtr FDBTMaxValuesConfig::LoadJsonTable(const FString& FilePath)
+{
+    const FDateTime FileTimestamp = IFileManager::Get().GetTimeStamp(*FilePath);
+
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTMaxValuesConfig: Could not load config file %s"), *FilePath);
+        return nullptr;
+    }
+
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTMaxValuesConfig: Could not parse JSON from file %s"), *FilePath);
+        return nullptr;
+    }
+
+    TSharedRef<FDBTMaxValuesTable, ESPMode::ThreadSafe> NewTable = MakeShared<FDBTMaxValuesTable, ESPMode::ThreadSafe>();
+    NewTable->SourceTimestamp = FileTimestamp;
+
+    for (const auto& Pair : JsonObject->Values)
+    {
+        double Number = 0.0;
+        if (Pair.Value.IsValid() && Pair.Value->TryGetNumber(Number))
+        {
+            NewTable->Values.Add(FName(*Pair.Key), Number);
+        }
+    }
+
+    return NewTable;
+}
+
+static FAutoConsoleCommand DBTConfigReloadCommand(
+    TEXT("dbt.Adjuster.ReloadConfig"),
+    TEXT("Reloads AIControllerMaxValues.json in the background."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        FDBTMaxValuesConfig::Get().RequestReload();
+    }));
+
+static FAutoConsoleCommand DBTConfigBakeCommand(
+    TEXT("dbt.Adjuster.BakeConfig"),
+    TEXT("Bakes AIControllerMaxValues.json into AIControllerMaxValues.bin, which is loaded without parsing."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        if (FDBTMaxValuesConfig::BakeBinaryConfig(FDBTMaxValuesConfig::GetConfigFilePath(), FDBTMaxValuesConfig::GetBinaryConfigFilePath()))
+        {
+            FDBTMaxValuesConfig::Get().RequestReload();
+        }
+    }));
@@ -1,142 +1,237 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "DBTPluginTest.h"
-#include "DBTBehaviorTreeDataManager.h"
-#include "DynamicTaskNode.h"
-#include "DynamicRootNodeCustomization.h"
-#include "DynamicAIControllerCustomization.h"
-#include "AbilityCounterComponent.h"
-#include "AssetTypeActions_Base.h"
-#include "PropertyEditorModule.h"
-#include "BehaviorTree/BTTaskNode.h"
-
-#define LOCTEXT_NAMESPACE "FDBTPluginTestModule"
-
-void FDBTPluginTestModule::StartupModule()
-{
-	GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Plugin loaded!"));
-
-#if WITH_EDITOR
-	RegisterTaskNodeCustomizations();
-#endif
-}
-
-void FDBTPluginTestModule::ShutdownModule()
-{
-	GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Plugin unloaded!"));
-
-#if WITH_EDITOR
-	UnregisterTaskNodeCustomizations();
-
-	FTaskNodeCustomization::ClearFlagsMap();
-#endif
-
-	UDBTBehaviorTreeDataManager::Release();
-}
-
-#if WITH_EDITOR
-void FDBTPluginTestModule::RegisterTaskNodeCustomizations()
-{
-	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
-	{
-		FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
-
-		// List of standard Task classes for registration
-		TArray<FName> TaskClassNames = {
-			FName("BTTaskNode"),                 // Base class for all BT Tasks
-			FName("BTTask_BlackboardBase"),      // Base class with Blackboard
-			FName("BTTask_BlueprintBase"),       // Blueprint-based task
-			FName("BTTask_Wait"),                // Task Wait
-			FName("BTTask_MoveTo"),              // Task MoveTo
-			FName("BTTask_RotateToFaceBBEntry"), // Task RotateToFaceBBEntry
-			FName("BTTask_PlayAnimation"),       // Task PlayAnimation
-			FName("BTTask_RunEQSQuery")          // Task RunEQSQuery
-		};
-
-		int length_standart_class = 0;
-		for (const FName& ClassName : TaskClassNames)
-		{
-			PropertyModule.RegisterCustomClassLayout(
-				ClassName,
-				FOnGetDetailCustomizationInstance::CreateStatic(&FTaskNodeCustomization::MakeInstance)
-			);
-
-			length_standart_class++;
-		}
-
-		if (length_standart_class == TaskClassNames.Num())
-		{
-			GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Standart task nodes customizations registered successfully"));
-		}
-
-		RegisterAllTaskClasses(PropertyModule);
-
-		PropertyModule.RegisterCustomClassLayout(
-			FName("BTCompositeNode"),
-			FOnGetDetailCustomizationInstance::CreateStatic(&FBehaviorTreeRootNodeCustomization::MakeInstance)
-		);
-
-		PropertyModule.RegisterCustomClassLayout(
-			FName("AIController"),
-			FOnGetDetailCustomizationInstance::CreateStatic(&FDynamicAIControllerCustomization::MakeInstance)
-		);
-
-		GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Root nodes customizations registered successfully"));
-
-		PropertyModule.NotifyCustomizationModuleChanged();
-
-		GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: All task nodes customizations registered successfully"));
-	}
-}
-
-void FDBTPluginTestModule::RegisterAllTaskClasses(FPropertyEditorModule& PropertyModule)
-{
-	UClass* BTTaskNodeClass = UBTTaskNode::StaticClass();
-
-	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
-	{
-		UClass* CurrentClass = *ClassIt;
-
-		if (CurrentClass->IsChildOf(BTTaskNodeClass))
-		{
-			if (CurrentClass != BTTaskNodeClass &&
-				!CurrentClass->GetName().StartsWith("BTTask_"))
-			{
-				PropertyModule.RegisterCustomClassLayout(
-					CurrentClass->GetFName(),
-					FOnGetDetailCustomizationInstance::CreateStatic(&FTaskNodeCustomization::MakeInstance)
-				);
-
-				GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Registered customization for custom task %s"), *CurrentClass->GetName());
-			}
-		}
-	}
-}
-
-void FDBTPluginTestModule::UnregisterTaskNodeCustomizations()
-{
-	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
-	{
-		FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
-
-		PropertyModule.UnregisterCustomClassLayout(FName("DynamicBTTaskNode"));
-		PropertyModule.UnregisterCustomClassLayout(FName("DynamicBTCompositeNode"));
-
-		PropertyModule.UnregisterCustomClassLayout(FName("AIController"));
-
-		PropertyModule.NotifyCustomizationModuleChanged();
-
-		GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Dynamic node customizations unregistered"));
-	}
-}
-#endif
-
-void FDBTPluginTestModule::RegisterAssetTypeAction(IAssetTools& AssetTools, TSharedRef<class IAssetTypeActions> Action)
-{
-	AssetTools.RegisterAssetTypeActions(Action);
-	CreatedAssetTypeActions.Add(Action);
-}
-
-#undef LOCTEXT_NAMESPACE
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTPluginTest.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "DBTTelemetry.h"
+#include "DBTUsageAggregator.h"
+#include "DBTAbilityUsageTable.h"
+#include "DBTMaxValuesConfig.h"
+#include "DBTMaxPropertyLayout.h"
+#include "DBTMaxAttributeAdjuster.h"
+#include "DBTAssetRegistryTags.h"
+#include "DBTBehaviorTreeIndex.h"
+#include "DBTDebugTrace.h"
+#include "GameplayDebuggerCategory_DynamicBehavior.h"
+#include "SDBTDynamicBehaviorBrowser.h"
+#include "Framework/Application/SlateApplication.h"
+#include "DynamicTaskNode.h"
+#include "DynamicRootNodeCustomization.h"
+#include "DynamicAIControllerCustomization.h"
+#include "AbilityCounterComponent.h"
+#include "AssetTypeActions_Base.h"
+#include "PropertyEditorModule.h"
+#include "Misc/CoreDelegates.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "FDBTPluginTestModule"
+
+void FDBTPluginTestModule::StartupModule()
+{
+	// Runtime singletons are created on first use; only registrations happen here, after engine init
+	if (IsRunningCommandlet())
+	{
+		OnPostEngineInit();
+		while (TickStartupStages(0.0f))
+		{
+		}
+	}
+	else if (GIsRunning)
+	{
+		OnPostEngineInit();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FDBTPluginTestModule::OnPostEngineInit);
+	}
+
+	GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Plugin loaded!"));
+}
+
+void FDBTPluginTestModule::OnPostEngineInit()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	PostEngineInitHandle.Reset();
+
+#if WITH_GAMEPLAY_DEBUGGER
+	PendingStartupStages.Add({ TEXT("GameplayDebugger"), []()
+	{
+		IGameplayDebugger& GameplayDebugger = IGameplayDebugger::Get();
+		GameplayDebugger.RegisterCategory("DynamicBehavior", IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_DynamicBehavior::MakeInstance), EGameplayDebuggerCategoryState::EnabledInGameAndSimulate);
+		GameplayDebugger.NotifyCategoriesChanged();
+	}, []()
+	{
+		if (IGameplayDebugger::IsAvailable())
+		{
+			IGameplayDebugger& GameplayDebugger = IGameplayDebugger::Get();
+			GameplayDebugger.UnregisterCategory("DynamicBehavior");
+			GameplayDebugger.NotifyCategoriesChanged();
+		}
+	} });
+#endif
+
+#if WITH_EDITOR
+	if (GIsEditor && !IsRunningDedicatedServer())
+	{
+		PendingStartupStages.Add({ TEXT("DetailCustomizations"), [this]()
+		{
+			RegisterTaskNodeCustomizations();
+			PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FDBTPluginTestModule::PruneCustomizationMaps);
+		}, [this]()
+		{
+			FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+			PostGarbageCollectHandle.Reset();
+			UnregisterTaskNodeCustomizations();
+			FTaskNodeCustomization::ClearFlagsMap();
+		} });
+		PendingStartupStages.Add({ TEXT("AssetRegistryTags"), []() { FDBTAssetRegistryTags::Register(); }, []() { FDBTAssetRegistryTags::Unregister(); } });
+
+		if (!IsRunningCommandlet())
+		{
+			PendingStartupStages.Add({ TEXT("BrowserTab"), []() { SDBTDynamicBehaviorBrowser::RegisterTabSpawner(); }, []()
+			{
+				if (FSlateApplication::IsInitialized())
+				{
+					SDBTDynamicBehaviorBrowser::UnregisterTabSpawner();
+				}
+			} });
+		}
+	}
+#endif
+
+	if (PendingStartupStages.Num() > 0 && !IsRunningCommandlet())
+	{
+		StartupTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FDBTPluginTestModule::TickStartupStages), 0.0f);
+	}
+}
+
+bool FDBTPluginTestModule::TickStartupStages(float DeltaTime)
+{
+	if (PendingStartupStages.Num() == 0)
+	{
+		return false;
+	}
+
+	const FStartupStage Stage = PendingStartupStages[0];
+	PendingStartupStages.RemoveAt(0);
+	RunStartupStage(Stage);
+
+	if (PendingStartupStages.Num() == 0)
+	{
+		GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Deferred startup finished, %.2f ms spent in startup stages"), StartupStagesSeconds * 1000.0);
+		StartupTickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FDBTPluginTestModule::RunStartupStage(const FStartupStage& Stage)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	Stage.Run();
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	StartupStagesSeconds += Elapsed;
+	CompletedStartupStages.Add(Stage);
+	StartupStageTimings.Add({ Stage.Name, Elapsed });
+	GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Startup stage %s took %.2f ms"), Stage.Name, Elapsed * 1000.0);
+}
+
+void FDBTPluginTestModule::ShutdownModule()
+{
+	GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Plugin unloaded!"));
+
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	if (StartupTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(StartupTickerHandle);
+		StartupTickerHandle.Reset();
+	}
+	PendingStartupStages.Empty();
+
+	for (int32 StageIndex = CompletedStartupStages.Num() - 1; StageIndex >= 0; StageIndex--)
+	{
+		CompletedStartupStages[StageIndex].Shutdown();
+	}
+	CompletedStartupStages.Empty();
+
+	UDBTBehaviorTreeDataManager::Release();
+	FDBTTelemetry::Release();
+	FDBTUsageAggregator::Release();
+	FDBTAbilityUsageTable::Release();
+	FDBTMaxValuesConfig::Release();
+	FDBTMaxPropertyLayoutCache::Release();
+	FDBTMaxAttributeAdjuster::Release();
+	FDBTBehaviorTreeIndexLoader::Release();
+	FDBTDebugTrace::Release();
+}
+
+#if WITH_EDITOR
+void FDBTPluginTestModule::RegisterTaskNodeCustomizations()
+{
+	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
+	{
+		FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+
+		// Detail layouts registered for a class also apply to all of its subclasses, including
+		// Blueprint tasks and tasks from modules loaded later, so the base class is enough
+		PropertyModule.RegisterCustomClassLayout(
+			FName("BTTaskNode"),
+			FOnGetDetailCustomizationInstance::CreateStatic(&FTaskNodeCustomization::MakeInstance)
+		);
+
+		GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Task nodes customization registered successfully"));
+
+		PropertyModule.RegisterCustomClassLayout(
+			FName("BTCompositeNode"),
+			FOnGetDetailCustomizationInstance::CreateStatic(&FBehaviorTreeRootNodeCustomization::MakeInstance)
+		);
+
+		PropertyModule.RegisterCustomClassLayout(
+			FName("AIController"),
+			FOnGetDetailCustomizationInstance::CreateStatic(&FDynamicAIControllerCustomization::MakeInstance)
+		);
+
+		GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Root nodes customizations registered successfully"));
+
+		PropertyModule.NotifyCustomizationModuleChanged();
+
+		GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: All task nodes customizations registered successfully"));
+	}
+}
+
+void FDBTPluginTestModule::PruneCustomizationMaps()
+{
+	// Deleted nodes and unloaded assets leave keys that can never resolve again
+	FTaskNodeCustomization::PruneStaleEntries();
+}
+
+void FDBTPluginTestModule::UnregisterTaskNodeCustomizations()
+{
+	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
+	{
+		FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+
+		PropertyModule.UnregisterCustomClassLayout(FName("BTTaskNode"));
+		PropertyModule.UnregisterCustomClassLayout(FName("BTCompositeNode"));
+
+		PropertyModule.UnregisterCustomClassLayout(FName("AIController"));
+
+		PropertyModule.NotifyCustomizationModuleChanged();
+
+		GLog->Logf(ELogVerbosity::Display, TEXT("Dynamic Behavior Tree Plugin: Dynamic node customizations unregistered"));
+	}
+}
+#endif
+
+void FDBTPluginTestModule::RegisterAssetTypeAction(IAssetTools& AssetTools, TSharedRef<class IAssetTypeActions> Action)
+{
+	AssetTools.RegisterAssetTypeActions(Action);
+	CreatedAssetTypeActions.Add(Action);
+}
+
+#undef LOCTEXT_NAMESPACE
+
 IMPLEMENT_MODULE(FDBTPluginTestModule, DBTPluginTest)
\ No newline at end of file
@@ -0,0 +1,554 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTTelemetry.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Engine/Engine.h"
+
+static TAutoConsoleVariable<int32> CVarDBTTelemetryEnabled(
+    TEXT("dbt.Telemetry.Enabled"),
+    0,
+    TEXT("Write ability activations and priority swaps to the binary telemetry stream (0 = off, 1 = on)."));
+
+static TAutoConsoleVariable<int32> CVarDBTTelemetryMaxFileSizeMB(
+    TEXT("dbt.Telemetry.MaxFileSizeMB"),
+    64,
+    TEXT("Size in megabytes after which the telemetry writer rolls over to a new file."));
+
+static TAutoConsoleVariable<int32> CVarDBTTelemetryMaxFiles(
+    TEXT("dbt.Telemetry.MaxFiles"),
+    8,
+    TEXT("Number of rolled telemetry files kept on disk per session; older files are deleted."));
+
+namespace DBTTelemetry
+{
+    template<typename T>
+    FORCEINLINE void Append(TArray<uint8>& Buffer, T Value)
+    {
+        Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+    }
+
+    static FString GetTelemetryDir()
+    {
+        return FPaths::ProjectSavedDir() / TEXT("Telemetry") / TEXT("DBT");
+    }
+}
+
+class FDBTTelemetryWriter : public FRunnable
+{
+public:
+    explicit FDBTTelemetryWriter(FDBTTelemetry& InOwner)
+        : Owner(InOwner)
+        , Thread(nullptr)
+        , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+        , FlushDoneEvent(FPlatformProcess::GetSynchEventFromPool(false))
+        , bStopRequested(false)
+        , bFlushRequested(false)
+        , FlushTarget(0)
+        , FileStartTime(0.0)
+        , FileBytes(0)
+        , FileIndex(0)
+    {
+        SessionPrefix = FString::Printf(TEXT("DBT_%s"), *FDateTime::UtcNow().ToString(TEXT("%Y%m%d_%H%M%S")));
+        Thread = FRunnableThread::Create(this, TEXT("DBTTelemetryWriter"), 0, TPri_BelowNormal);
+    }
+
+    virtual ~FDBTTelemetryWriter()
+    {
+        if (Thread)
+        {
+            Thread->Kill(true);
+            delete Thread;
+            Thread = nullptr;
+        }
+
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        FPlatformProcess::ReturnSynchEventToPool(FlushDoneEvent);
+    }
+
+    virtual uint32 Run() override
+    {
+        while (!bStopRequested.load(std::memory_order_acquire))
+        {
+            WakeEvent->Wait(100);
+            Drain();
+
+            if (bFlushRequested.exchange(false, std::memory_order_acquire))
+            {
+                // Producers claim a slot before they publish its event, so keep draining until
+                // every slot claimed before the flush was requested has been written
+                const uint64 Target = FlushTarget.load(std::memory_order_relaxed);
+                while (Owner.DequeuePos.load(std::memory_order_acquire) < Target && !bStopRequested.load(std::memory_order_acquire))
+                {
+                    FPlatformProcess::Sleep(0.0f);
+                    Drain();
+                }
+                FlushDoneEvent->Trigger();
+            }
+        }
+
+        Drain();
+        CloseFile();
+        FlushDoneEvent->Trigger();
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStopRequested.store(true, std::memory_order_release);
+        WakeEvent->Trigger();
+    }
+
+    void RequestFlush(uint64 TargetPos)
+    {
+        FlushTarget.store(TargetPos, std::memory_order_relaxed);
+        bFlushRequested.store(true, std::memory_order_release);
+        WakeEvent->Trigger();
+        FlushDoneEvent->Wait(5000);
+    }
+
+private:
+    void Drain()
+    {
+        FDBTTelemetryEvent Event;
+        while (Owner.Pop(Event))
+        {
+            if (!File.IsValid())
+            {
+                OpenNextFile();
+            }
+
+            WriteEvent(Event);
+
+            if (Buffer.Num() >= 64 * 1024)
+            {
+                WriteBuffer();
+            }
+        }
+
+        WriteBuffer();
+    }
+
+    void WriteBuffer()
+    {
+        if (Buffer.Num() == 0 || !File.IsValid())
+        {
+            Buffer.Reset();
+            return;
+        }
+
+        File->Serialize(Buffer.GetData(), Buffer.Num());
+        File->Flush();
+        FileBytes += Buffer.Num();
+        Buffer.Reset();
+
+        const int64 MaxFileBytes = (int64)FMath::Max(1, CVarDBTTelemetryMaxFileSizeMB.GetValueOnAnyThread()) * 1024 * 1024;
+        if (FileBytes >= MaxFileBytes)
+        {
+            CloseFile();
+        }
+    }
+
+    void OpenNextFile()
+    {
+        const FString FilePath = DBTTelemetry::GetTelemetryDir() / FString::Printf(TEXT("%s_%03d.dbtt"), *SessionPrefix, FileIndex++);
+        File.Reset(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_AllowRead));
+        if (!File.IsValid())
+        {
+            GLog->Logf(ELogVerbosity::Warning, TEXT("DBTTelemetry: Could not open telemetry file %s"), *FilePath);
+            return;
+        }
+
+        WrittenFiles.Add(FilePath);
+        const int32 MaxFiles = FMath::Max(1, CVarDBTTelemetryMaxFiles.GetValueOnAnyThread());
+        while (WrittenFiles.Num() > MaxFiles)
+        {
+            IFileManager::Get().Delete(*WrittenFiles[0]);
+            WrittenFiles.RemoveAt(0);
+        }
+
+        NameIds.Reset();
+        FileStartTime = FPlatformTime::Seconds();
+        FileBytes = 0;
+
+        DBTTelemetry::Append<uint32>(Buffer, FDBTTelemetry::FileMagic);
+        DBTTelemetry::Append<uint16>(Buffer, FDBTTelemetry::FileVersion);
+        DBTTelemetry::Append<uint16>(Buffer, 0);
+        DBTTelemetry::Append<int64>(Buffer, FDateTime::UtcNow().GetTicks());
+    }
+
+    void CloseFile()
+    {
+        if (File.IsValid())
+        {
+            File->Close();
+            File.Reset();
+        }
+    }
+
+    uint32 GetNameId(FName Name)
+    {
+        if (const uint32* Existing = NameIds.Find(Name))
+        {
+            return *Existing;
+        }
+
+        const uint32 NewId = NameIds.Num() + 1;
+        NameIds.Add(Name, NewId);
+
+        FTCHARToUTF8 Utf8(*Name.ToString());
+        const uint16 Length = (uint16)FMath::Min(Utf8.Length(), (int32)MAX_uint16);
+
+        DBTTelemetry::Append<uint8>(Buffer, (uint8)EDBTTelemetryRecordType::NameDefinition);
+        DBTTelemetry::Append<uint32>(Buffer, NewId);
+        DBTTelemetry::Append<uint16>(Buffer, Length);
+        Buffer.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+
+        return NewId;
+    }
+
+    void WriteEvent(const FDBTTelemetryEvent& Event)
+    {
+        // Name definitions must precede the record referencing them
+        const uint32 PrimaryId = Event.Primary.IsNone() ? 0 : GetNameId(Event.Primary);
+        const uint32 SecondaryId = Event.Secondary.IsNone() ? 0 : GetNameId(Event.Secondary);
+        const uint32 TimeMs = (uint32)FMath::Max(0.0, (Event.Timestamp - FileStartTime) * 1000.0);
+
+        DBTTelemetry::Append<uint8>(Buffer, (uint8)Event.Type);
+        DBTTelemetry::Append<uint32>(Buffer, TimeMs);
+        DBTTelemetry::Append<uint32>(Buffer, PrimaryId);
+        DBTTelemetry::Append<uint32>(Buffer, SecondaryId);
+
+        if (Event.Type == EDBTTelemetryRecordType::AbilityActivated)
+        {
+            DBTTelemetry::Append<uint8>(Buffer, Event.Category);
+            DBTTelemetry::Append<int32>(Buffer, Event.ValueA);
+        }
+        else
+        {
+            DBTTelemetry::Append<int32>(Buffer, Event.ValueA);
+            DBTTelemetry::Append<int32>(Buffer, Event.ValueB);
+        }
+    }
+
+    FDBTTelemetry& Owner;
+    FRunnableThread* Thread;
+    FEvent* WakeEvent;
+    FEvent* FlushDoneEvent;
+    std::atomic<bool> bStopRequested;
+    std::atomic<bool> bFlushRequested;
+    std::atomic<uint64> FlushTarget;
+
+    TUniquePtr<FArchive> File;
+    TArray<uint8> Buffer;
+    TMap<FName, uint32> NameIds;
+    double FileStartTime;
+    int64 FileBytes;
+    int32 FileIndex;
+    FString SessionPrefix;
+    TArray<FString> WrittenFiles;
+};
+
+FDBTTelemetry* FDBTTelemetry::Instance = nullptr;
+
+FDBTTelemetry& FDBTTelemetry::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FDBTTelemetry();
+    }
+    return *Instance;
+}
+
+void FDBTTelemetry::Release()
+{
+    if (Instance)
+    {
+        delete Instance;
+        Instance = nullptr;
+    }
+}
+
+bool FDBTTelemetry::IsEnabled()
+{
+    return CVarDBTTelemetryEnabled.GetValueOnAnyThread() != 0;
+}
+
+FDBTTelemetry::FDBTTelemetry()
+    : Ring(MakeUnique<FSlot[]>(RingCapacity))
+    , EnqueuePos(0)
+    , DequeuePos(0)
+    , DroppedEvents(0)
+    , bWriterStarted(false)
+{
+    for (uint32 i = 0; i < RingCapacity; i++)
+    {
+        Ring[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+FDBTTelemetry::~FDBTTelemetry()
+{
+    Writer.Reset();
+
+    const uint64 Dropped = DroppedEvents.load();
+    if (Dropped > 0)
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTTelemetry: %llu events dropped because the ring buffer was full"), Dropped);
+    }
+}
+
+void FDBTTelemetry::RecordAbilityActivation(FName AbilityName, FName OwnerName, EAbilityCategory Category, int32 UsageCount)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    FDBTTelemetryEvent Event;
+    Event.Type = EDBTTelemetryRecordType::AbilityActivated;
+    Event.Category = (uint8)Category;
+    Event.Timestamp = FPlatformTime::Seconds();
+    Event.Primary = AbilityName;
+    Event.Secondary = OwnerName;
+    Event.ValueA = UsageCount;
+    Push(Event);
+}
+
+void FDBTTelemetry::RecordPrioritySwap(FName TreeName, FName CompositeName, int32 FirstIndex, int32 SecondIndex)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    FDBTTelemetryEvent Event;
+    Event.Type = EDBTTelemetryRecordType::PrioritySwap;
+    Event.Timestamp = FPlatformTime::Seconds();
+    Event.Primary = TreeName;
+    Event.Secondary = CompositeName;
+    Event.ValueA = FirstIndex;
+    Event.ValueB = SecondIndex;
+    Push(Event);
+}
+
+void FDBTTelemetry::Flush()
+{
+    if (bWriterStarted.load(std::memory_order_acquire))
+    {
+        Writer->RequestFlush(EnqueuePos.load(std::memory_order_acquire));
+    }
+}
+
+void FDBTTelemetry::EnsureWriterStarted()
+{
+    if (!bWriterStarted.load(std::memory_order_acquire))
+    {
+        FScopeLock Lock(&WriterStartLock);
+        if (!Writer.IsValid())
+        {
+            Writer = MakeUnique<FDBTTelemetryWriter>(*this);
+            bWriterStarted.store(true, std::memory_order_release);
+        }
+    }
+}
+
+void FDBTTelemetry::Push(const FDBTTelemetryEvent& Event)
+{
+    EnsureWriterStarted();
+
+    uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        FSlot& Slot = Ring[Pos & (RingCapacity - 1)];
+        const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+        const int64 Diff = (int64)Sequence - (int64)Pos;
+
+        if (Diff == 0)
+        {
+            if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+            {
+                Slot.Event = Event;
+                Slot.Sequence.store(Pos + 1, std::memory_order_release);
+                return;
+            }
+        }
+        else if (Diff < 0)
+        {
+            DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            Pos = EnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool FDBTTelemetry::Pop(FDBTTelemetryEvent& OutEvent)
+{
+    uint64 Pos = DequeuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        FSlot& Slot = Ring[Pos & (RingCapacity - 1)];
+        const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+        const int64 Diff = (int64)Sequence - (int64)(Pos + 1);
+
+        if (Diff == 0)
+        {
+            if (DequeuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+            {
+                OutEvent = Slot.Event;
+                Slot.Sequence.store(Pos + RingCapacity, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (Diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            Pos = DequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool FDBTTelemetryReader::ConvertToCSV(const FString& InFilePath, const FString& OutFilePath)
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *InFilePath))
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTTelemetryReader: Could not load telemetry file %s"), *InFilePath);
+        return false;
+    }
+
+    FString CSV;
+    const bool bComplete = ConvertToCSV(Data, CSV);
+    if (!bComplete)
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTTelemetryReader: %s is truncated or malformed, converted what could be read"), *InFilePath);
+    }
+
+    if (!FFileHelper::SaveStringToFile(CSV, *OutFilePath))
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("DBTTelemetryReader: Could not write CSV file %s"), *OutFilePath);
+        return false;
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("DBTTelemetryReader: Converted %s to %s"), *InFilePath, *OutFilePath);
+    return bComplete;
+}
+
+bool FDBTTelemetryReader::ConvertToCSV(const TArray<uint8>& InData, FString& OutCSV)
+{
+    FMemoryReader Ar(InData);
+
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    uint16 Reserved = 0;
+    int64 StartTicks = 0;
+    Ar << Magic << Version << Reserved << StartTicks;
+
+    if (Ar.IsError() || Magic != FDBTTelemetry::FileMagic || Version != FDBTTelemetry::FileVersion)
+    {
+        return false;
+    }
+
+    const FDateTime StartTime(StartTicks);
+    OutCSV = FString::Printf(TEXT("# Session start (UTC): %s\n"), *StartTime.ToIso8601());
+    OutCSV += TEXT("TimeMs,Event,AbilityOrTree,OwnerOrComposite,Category,UsageCount,FirstIndex,SecondIndex\n");
+
+    TMap<uint32, FString> Names;
+    auto ResolveName = [&Names](uint32 Id) -> FString
+    {
+        const FString* Name = Names.Find(Id);
+        return Name ? *Name : FString();
+    };
+
+    while (!Ar.AtEnd())
+    {
+        uint8 RawType = 0;
+        Ar << RawType;
+
+        const EDBTTelemetryRecordType Type = (EDBTTelemetryRecordType)RawType;
+        if (Type == EDBTTelemetryRecordType::NameDefinition)
+        {
+            uint32 Id = 0;
+            uint16 Length = 0;
+            Ar << Id << Length;
+
+            TArray<ANSICHAR> Utf8;
+            Utf8.SetNumZeroed(Length + 1);
+            Ar.Serialize(Utf8.GetData(), Length);
+            Names.Add(Id, FString(UTF8_TO_TCHAR(Utf8.GetData())));
+        }
+        else if (Type == EDBTTelemetryRecordType::AbilityActivated)
+        {
+            uint32 TimeMs = 0, AbilityId = 0, OwnerId = 0;
+            uint8 Category = 0;
+            int32 UsageCount = 0;
+            Ar << TimeMs << AbilityId << OwnerId << Category << UsageCount;
+
+            OutCSV += FString::Printf(TEXT("%u,AbilityActivated,%s,%s,%s,%d,,\n"),
+                TimeMs, *ResolveName(AbilityId), *ResolveName(OwnerId),
+                *UAbilityCategoryUtils::CategoryToText((EAbilityCategory)Category).ToString(), UsageCount);
+        }
+        else if (Type == EDBTTelemetryRecordType::PrioritySwap)
+        {
+            uint32 TimeMs = 0, TreeId = 0, CompositeId = 0;
+            int32 FirstIndex = 0, SecondIndex = 0;
+            Ar << TimeMs << TreeId << CompositeId << FirstIndex << SecondIndex;
+
+            OutCSV += FString::Printf(TEXT("%u,PrioritySwap,%s,%s,,,%d,%d\n"),
+                TimeMs, *ResolveName(TreeId), *ResolveName(CompositeId), FirstIndex, SecondIndex);
+        }
+        else
+        {
+            return false;
+        }
+
+        if (Ar.IsError())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static FAutoConsoleCommand DBTTelemetryFlushCommand(
+    TEXT("dbt.Telemetry.Flush"),
+    TEXT("Writes all pending telemetry events to disk."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        if (FDBTTelemetry* Telemetry = FDBTTelemetry::GetIfExists())
+        {
+            Telemetry->Flush();
+        }
+    }));
+
+static FAutoConsoleCommand DBTTelemetryToCSVCommand(
+    TEXT("dbt.Telemetry.ToCSV"),
+    TEXT("Converts a telemetry file to CSV. Usage: dbt.Telemetry.ToCSV <InFile> [OutFile]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.Num() == 0)
+        {
+            GLog->Logf(ELogVerbosity::Display, TEXT("Usage: dbt.Telemetry.ToCSV <InFile> [OutFile]"));
+            return;
+        }
+
+        const FString OutFile = Args.Num() > 1 ? Args[1] : FPaths::ChangeExtension(Args[0], TEXT("csv"));
+        FDBTTelemetryReader::ConvertToCSV(Args[0], OutFile);
+    }));
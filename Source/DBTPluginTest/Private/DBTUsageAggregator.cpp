@@ -0,0 +1,155 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTUsageAggregator.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Engine/Engine.h"
+
+std::atomic<FDBTUsageAggregator*> FDBTUsageAggregator::Instance(nullptr);
+
+static FCriticalSection GDBTUsageAggregatorCreateLock;
+
+FDBTUsageAggregator& FDBTUsageAggregator::Get()
+{
+    // Increments may arrive from any thread, so creation is double-checked
+    FDBTUsageAggregator* Current = Instance.load(std::memory_order_acquire);
+    if (!Current)
+    {
+        FScopeLock Lock(&GDBTUsageAggregatorCreateLock);
+        Current = Instance.load(std::memory_order_relaxed);
+        if (!Current)
+        {
+            Current = new FDBTUsageAggregator();
+            Instance.store(Current, std::memory_order_release);
+        }
+    }
+    return *Current;
+}
+
+void FDBTUsageAggregator::Release()
+{
+    FScopeLock Lock(&GDBTUsageAggregatorCreateLock);
+    delete Instance.exchange(nullptr);
+}
+
+static std::atomic<uint64> GDBTUsageAggregatorGeneration(0);
+
+FDBTUsageAggregator::FDBTUsageAggregator()
+    : Generation(++GDBTUsageAggregatorGeneration)
+{
+}
+
+FDBTUsageAggregator::FShard& FDBTUsageAggregator::GetThreadShard()
+{
+    struct FThreadShard
+    {
+        uint64 Generation = 0;
+        FShard* Shard = nullptr;
+    };
+    static thread_local FThreadShard ThreadShard;
+
+    if (ThreadShard.Generation != Generation)
+    {
+        FScopeLock Lock(&ShardsLock);
+        ThreadShard.Shard = Shards.Add_GetRef(MakeUnique<FShard>()).Get();
+        ThreadShard.Generation = Generation;
+    }
+    return *ThreadShard.Shard;
+}
+
+void FDBTUsageAggregator::RecordUsage(FName AbilityClassName, EAbilityCategory Category, int64 Count)
+{
+    FShard& Shard = GetThreadShard();
+
+    // Only contended while a snapshot is merging this shard
+    FScopeLock Lock(&Shard.Lock);
+    Shard.UsageByAbility.FindOrAdd(AbilityClassName) += Count;
+
+    const int32 CategoryIndex = (int32)Category;
+    if (CategoryIndex >= 0 && CategoryIndex < FDBTUsageSnapshot::NumCategories)
+    {
+        Shard.UsageByCategory[CategoryIndex] += Count;
+    }
+}
+
+FDBTUsageSnapshot FDBTUsageAggregator::GetSnapshot() const
+{
+    FDBTUsageSnapshot Snapshot;
+
+    FScopeLock Lock(&ShardsLock);
+    for (const TUniquePtr<FShard>& Shard : Shards)
+    {
+        FScopeLock ShardLock(&Shard->Lock);
+        for (const auto& Pair : Shard->UsageByAbility)
+        {
+            Snapshot.UsageByAbility.FindOrAdd(Pair.Key) += Pair.Value;
+        }
+
+        for (int32 i = 0; i < FDBTUsageSnapshot::NumCategories; i++)
+        {
+            Snapshot.UsageByCategory[i] += Shard->UsageByCategory[i];
+            Snapshot.TotalUsage += Shard->UsageByCategory[i];
+        }
+    }
+
+    return Snapshot;
+}
+
+void FDBTUsageAggregator::Reset()
+{
+    FScopeLock Lock(&ShardsLock);
+    for (const TUniquePtr<FShard>& Shard : Shards)
+    {
+        FScopeLock ShardLock(&Shard->Lock);
+        Shard->UsageByAbility.Reset();
+        FMemory::Memzero(Shard->UsageByCategory);
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("DBTUsageAggregator: All global usage counters reset"));
+}
+
+void FDBTUsageAggregator::DumpToLog() const
+{
+    const FDBTUsageSnapshot Snapshot = GetSnapshot();
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("=== Global Ability Usage (%lld total) ==="), Snapshot.TotalUsage);
+
+    for (int32 i = 0; i < FDBTUsageSnapshot::NumCategories; i++)
+    {
+        GLog->Logf(ELogVerbosity::Display, TEXT("  [%s]: %lld uses"),
+            *UAbilityCategoryUtils::CategoryToText((EAbilityCategory)i).ToString(), Snapshot.UsageByCategory[i]);
+    }
+
+    TArray<TPair<FName, int64>> SortedStats;
+    for (const auto& Pair : Snapshot.UsageByAbility)
+    {
+        SortedStats.Add(TPair<FName, int64>(Pair.Key, Pair.Value));
+    }
+
+    SortedStats.Sort([](const TPair<FName, int64>& A, const TPair<FName, int64>& B) {
+        return A.Value > B.Value;
+        });
+
+    for (const auto& Pair : SortedStats)
+    {
+        GLog->Logf(ELogVerbosity::Display, TEXT("  %s: %lld uses"), *Pair.Key.ToString(), Pair.Value);
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("=== End Global Usage ==="));
+}
+
+static FAutoConsoleCommand DBTUsageDumpCommand(
+    TEXT("dbt.Usage.Dump"),
+    TEXT("Prints global ability usage totals per ability class and per category."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        FDBTUsageAggregator::Get().DumpToLog();
+    }));
+
+static FAutoConsoleCommand DBTUsageResetCommand(
+    TEXT("dbt.Usage.Reset"),
+    TEXT("Resets global ability usage totals."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        FDBTUsageAggregator::Get().Reset();
+    }));
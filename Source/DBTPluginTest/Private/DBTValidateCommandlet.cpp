@@ -0,0 +1,330 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTValidateCommandlet.h"
+#include "DBTAssetRegistryTags.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "DBTBehaviorTreeIndex.h"
+#include "AbilityCategoryUtils.h"
+#include "AssetRegistryModule.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "GameFramework/Actor.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Parse.h"
+#include "HAL/FileManager.h"
+#include "UObject/UObjectGlobals.h"
+
+static const TCHAR* KnownCategories[] = { TEXT("Offensive Action"), TEXT("Defensive Action"), TEXT("Supporting Action") };
+
+static bool IsKnownCategory(const FString& Category)
+{
+    for (const TCHAR* Known : KnownCategories)
+    {
+        if (Category.Equals(Known, ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void CollectTreeNodes(const UBTCompositeNode* Composite, TArray<const UBTCompositeNode*>& OutComposites, TArray<const UBTTaskNode*>& OutTasks)
+{
+    OutComposites.Add(Composite);
+
+    for (const FBTCompositeChild& Child : Composite->Children)
+    {
+        if (Child.ChildComposite)
+        {
+            CollectTreeNodes(Child.ChildComposite, OutComposites, OutTasks);
+        }
+        else if (Child.ChildTask)
+        {
+            OutTasks.Add(Child.ChildTask);
+        }
+    }
+}
+
+UDBTValidateCommandlet::UDBTValidateCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UDBTValidateCommandlet::Main(const FString& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    FString IndexDirectory;
+    FParse::Value(*Params, TEXT("IndexDir="), IndexDirectory);
+    const bool bAllTrees = FParse::Param(*Params, TEXT("AllTrees"));
+    const bool bCheckOnly = FParse::Param(*Params, TEXT("CheckOnly"));
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    // Trees saved with summary tags that say "no dynamic data" are skipped unless -AllTrees is passed
+    TArray<FAssetData> TreeAssets;
+    AssetRegistry.GetAssetsByClass(UBehaviorTree::StaticClass()->GetFName(), TreeAssets, true);
+    if (!bAllTrees)
+    {
+        TreeAssets.RemoveAll([bCheckOnly, &IndexDirectory](const FAssetData& AssetData)
+        {
+            FDBTBehaviorTreeSummary Summary;
+            if (!FDBTBehaviorTreeSummary::FromAssetData(AssetData, Summary) || Summary.HasDynamicData())
+            {
+                return false;
+            }
+
+            // A tree whose dynamic data was cleared must not keep its old index
+            if (!bCheckOnly)
+            {
+                IFileManager::Get().Delete(*FDBTBehaviorTreeIndex::GetIndexFilePath(AssetData.ToSoftObjectPath(), IndexDirectory), false, false, true);
+            }
+            return true;
+        });
+    }
+
+    // Queue every package at once so the async loader can overlap IO, then wait for all of them
+    for (const FAssetData& AssetData : TreeAssets)
+    {
+        LoadPackageAsync(AssetData.PackageName.ToString());
+    }
+    FlushAsyncLoading();
+
+    UDBTBehaviorTreeDataManager::Get();
+
+    TArray<FIssue> Issues;
+    TArray<UBehaviorTree*> Trees;
+    TArray<TArray<FIssue>> TreeIssues;
+    int32 NumIndexFiles = 0;
+    int32 NumBakedFiles = 0;
+
+    for (const FAssetData& AssetData : TreeAssets)
+    {
+        UBehaviorTree* BehaviorTree = Cast<UBehaviorTree>(AssetData.GetAsset());
+        if (!BehaviorTree)
+        {
+            continue;
+        }
+
+        Trees.Add(BehaviorTree);
+        TArray<FIssue>& TreeIssueList = TreeIssues.AddDefaulted_GetRef();
+        const FString TreePath = AssetData.ObjectPath.ToString();
+
+        // The registry tags hold the saved data, so the index runtime builds load is baked from
+        // them and then validated as the runtime would see it
+        const FDBTBehaviorTreeIndex TaggedIndex = FDBTBehaviorTreeIndex::FromAssetData(AssetData);
+        const FString IndexFilePath = FDBTBehaviorTreeIndex::GetIndexFilePath(TaggedIndex.TreePath, IndexDirectory);
+
+        FDBTBehaviorTreeIndex SavedIndex;
+        const bool bHasIndexFile = SavedIndex.LoadFromFile(IndexFilePath);
+
+        if (bCheckOnly)
+        {
+            if (!bHasIndexFile)
+            {
+                if (!TaggedIndex.IsEmpty())
+                {
+                    TreeIssueList.Add({ TreePath, TEXT("Tree has dynamic data but no index file; run without -CheckOnly to bake it"), true });
+                }
+                continue;
+            }
+
+            if (!SavedIndex.HasSameEntries(TaggedIndex))
+            {
+                TreeIssueList.Add({ TreePath, TEXT("Index file does not match the data saved in the tree; run without -CheckOnly to bake it"), true });
+            }
+        }
+        else
+        {
+            if (TaggedIndex.IsEmpty())
+            {
+                IFileManager::Get().Delete(*IndexFilePath, false, false, true);
+                continue;
+            }
+
+            if (!bHasIndexFile || !SavedIndex.HasSameEntries(TaggedIndex))
+            {
+                if (!TaggedIndex.SaveToFile(IndexFilePath))
+                {
+                    TreeIssueList.Add({ TreePath, FString::Printf(TEXT("Could not write index file %s"), *IndexFilePath), true });
+                    continue;
+                }
+                NumBakedFiles++;
+            }
+        }
+
+        NumIndexFiles++;
+
+        const FDBTBehaviorTreeIndex& RuntimeIndex = bCheckOnly ? SavedIndex : TaggedIndex;
+
+        TArray<FName> UnresolvedNodes;
+        RuntimeIndex.ApplyToBehaviorTree(BehaviorTree, &UnresolvedNodes);
+
+        for (const FName& NodeName : UnresolvedNodes)
+        {
+            TreeIssueList.Add({ TreePath, FString::Printf(TEXT("Index entry for node %s no longer matches a node in the tree"), *NodeName.ToString()), false });
+        }
+    }
+
+    // Node walks only read loaded objects and the data manager, so trees run in parallel
+    ParallelFor(Trees.Num(), [&](int32 Index)
+    {
+        ValidateBehaviorTree(Trees[Index], TreeIssues[Index]);
+    });
+
+    TSet<const UObject*> ScannedObjects;
+    for (int32 Index = 0; Index < Trees.Num(); Index++)
+    {
+        Issues.Append(TreeIssues[Index]);
+
+        if (Trees[Index]->RootNode)
+        {
+            TArray<const UBTCompositeNode*> Composites;
+            TArray<const UBTTaskNode*> Tasks;
+            CollectTreeNodes(Trees[Index]->RootNode, Composites, Tasks);
+            for (const UBTCompositeNode* Composite : Composites)
+            {
+                ScannedObjects.Add(Composite);
+            }
+            for (const UBTTaskNode* Task : Tasks)
+            {
+                ScannedObjects.Add(Task);
+            }
+        }
+    }
+
+    // Controllers in Blueprints and maps are checked from their registry tags, without loading them
+    TArray<FAssetData> ControllerAssets;
+    FDBTAssetRegistryTags::FindControllerAssets(ControllerAssets);
+
+    int32 NumControllers = 0;
+    for (const FAssetData& AssetData : ControllerAssets)
+    {
+        TArray<FDBTTaggedEntry> Entries;
+        FDBTAssetRegistryTags::ReadEntries(AssetData, FDBTAssetRegistryTags::DynamicControllersTag, Entries);
+        for (const FDBTTaggedEntry& Entry : Entries)
+        {
+            bool bDynamic = false;
+            int32 TimeLimit = 0;
+            if (FDBTAssetRegistryTags::ParseControllerEntry(Entry, bDynamic, TimeLimit))
+            {
+                ValidateAIController(AssetData.ObjectPath.ToString() + TEXT(":") + Entry.Name, bDynamic, TimeLimit, Issues);
+                NumControllers++;
+            }
+        }
+    }
+
+    ValidateOrphans(ScannedObjects, Issues);
+
+    int32 NumErrors = 0;
+    for (const FIssue& Issue : Issues)
+    {
+        GLog->Logf(Issue.bError ? ELogVerbosity::Error : ELogVerbosity::Warning, TEXT("DBTValidate: %s: %s"), *Issue.Path, *Issue.Message);
+        NumErrors += Issue.bError ? 1 : 0;
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("DBTValidate: Checked %d Behavior Tree(s) with %d index file(s) (%d baked) and %d AI controller(s), %d error(s), %d warning(s) in %.2fs"),
+        Trees.Num(), NumIndexFiles, NumBakedFiles, NumControllers, NumErrors, Issues.Num() - NumErrors, FPlatformTime::Seconds() - StartTime);
+
+    return NumErrors > 0 ? 1 : 0;
+}
+
+void UDBTValidateCommandlet::ValidateBehaviorTree(const UBehaviorTree* BehaviorTree, TArray<FIssue>& OutIssues)
+{
+    if (!BehaviorTree->RootNode)
+    {
+        return;
+    }
+
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+    const FString TreePath = BehaviorTree->GetPathName();
+
+    TArray<const UBTCompositeNode*> Composites;
+    TArray<const UBTTaskNode*> Tasks;
+    CollectTreeNodes(BehaviorTree->RootNode, Composites, Tasks);
+
+    for (const UBTCompositeNode* Composite : Composites)
+    {
+        UBTCompositeNode* MutableComposite = const_cast<UBTCompositeNode*>(Composite);
+        if (Composite != BehaviorTree->RootNode && DataManager.HasLimitChangeForNode(MutableComposite))
+        {
+            OutIssues.Add({ TreePath, FString::Printf(TEXT("Limit change %d is set on non-root composite %s and is ignored at runtime"),
+                DataManager.GetLimitChangeForNode(MutableComposite), *Composite->GetName()), true });
+        }
+    }
+
+    TSet<EAbilityCategory> UsedCategories;
+    for (const UBTTaskNode* Task : Tasks)
+    {
+        UBTTaskNode* MutableTask = const_cast<UBTTaskNode*>(Task);
+        if (!DataManager.GetTaskNodeIsDynamic(MutableTask))
+        {
+            continue;
+        }
+
+        const FString Category = DataManager.GetTaskNodeCategory(MutableTask);
+        if (!IsKnownCategory(Category))
+        {
+            OutIssues.Add({ TreePath, FString::Printf(TEXT("Dynamic task %s has unknown category '%s'"), *Task->GetName(), *Category), true });
+            continue;
+        }
+
+        UsedCategories.Add(UAbilityCategoryUtils::TextToCategory(FText::FromString(Category)));
+    }
+
+    // Swaps need a task of the opposite category in the same tree
+    for (EAbilityCategory Category : UsedCategories)
+    {
+        const EAbilityCategory Opposite = UAbilityCategoryUtils::GetOppositeCategory(Category);
+        if (!UsedCategories.Contains(Opposite))
+        {
+            OutIssues.Add({ TreePath, FString::Printf(TEXT("Category '%s' has no dynamic task of its opposite category '%s' to swap with"),
+                *UAbilityCategoryUtils::CategoryToText(Category).ToString(), *UAbilityCategoryUtils::CategoryToText(Opposite).ToString()), false });
+        }
+    }
+}
+
+void UDBTValidateCommandlet::ValidateAIController(const FString& ControllerPath, bool bDynamic, int32 TimeLimit, TArray<FIssue>& OutIssues)
+{
+    if (bDynamic && TimeLimit <= 0)
+    {
+        OutIssues.Add({ ControllerPath, TEXT("Dynamic behavior is enabled without a positive time limit"), true });
+    }
+    else if (!bDynamic && TimeLimit > 0)
+    {
+        OutIssues.Add({ ControllerPath, FString::Printf(TEXT("Time limit %d is set but dynamic behavior is disabled"), TimeLimit), false });
+    }
+}
+
+void UDBTValidateCommandlet::ValidateOrphans(const TSet<const UObject*>& ScannedObjects, TArray<FIssue>& OutIssues)
+{
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+
+    auto CheckEntry = [&ScannedObjects, &OutIssues](const TWeakObjectPtr<UObject>& Key, const TCHAR* Kind)
+    {
+        const UObject* Object = Key.Get();
+        if (!Object)
+        {
+            OutIssues.Add({ TEXT("DataManager"), FString::Printf(TEXT("%s entry refers to an object that no longer exists"), Kind), false });
+        }
+        else if (!ScannedObjects.Contains(Object) && !Object->IsA<AActor>())
+        {
+            OutIssues.Add({ Object->GetPathName(), FString::Printf(TEXT("%s entry is not reachable from any Behavior Tree"), Kind), false });
+        }
+    };
+
+    for (const auto& Pair : DataManager.GetAllTaskNodeDynamicFlags())
+    {
+        CheckEntry(Pair.Key, TEXT("Dynamic task"));
+    }
+
+    for (const auto& Pair : DataManager.GetAllLimitChanges())
+    {
+        CheckEntry(Pair.Key, TEXT("Limit change"));
+    }
+}
@@ -1,2 +1,2 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
+// Copyright Epic Games, Inc. All Rights Reserved.
+
@@ -1,112 +1,120 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "DynamicRootNodeCustomization.h"
-#include "DetailLayoutBuilder.h"
-#include "DetailCategoryBuilder.h"
-#include "DetailWidgetRow.h"
-#include "Widgets/Input/SSpinBox.h"
-#include "Widgets/Text/STextBlock.h"
-#include "BehaviorTree/BTCompositeNode.h"
-#include "DBTBehaviorTreeDataManager.h"
-
-TMap<FObjectKey, int32> FBehaviorTreeRootNodeCustomization::RootLimitChangeMap;
-
-TSharedRef<IDetailCustomization> FBehaviorTreeRootNodeCustomization::MakeInstance()
-{
-    return MakeShareable(new FBehaviorTreeRootNodeCustomization);
-}
-
-void FBehaviorTreeRootNodeCustomization::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
-{
-    DetailBuilder.GetObjectsBeingCustomized(CustomizedObjects);
-
-    if (CustomizedObjects.Num() == 0)
-        return;
-
-    bool bIsRoot = false;
-    for (auto& Obj : CustomizedObjects)
-    {
-        if (UBTCompositeNode* Node = Cast<UBTCompositeNode>(Obj.Get()))
-        {
-            UBTCompositeNode* ParentNode = Node->GetParentNode();
-            if (ParentNode == nullptr)
-            {
-                bIsRoot = true;
-            }
-            else
-            {
-                bIsRoot = false;
-                break;
-            }
-        }
-    }
-
-    if (!bIsRoot) return;
-
-    IDetailCategoryBuilder& RootCategory = DetailBuilder.EditCategory(
-        "Root Settings",
-        FText::FromString("Root Settings"),
-        ECategoryPriority::Important
-    );
-
-    RootCategory.AddCustomRow(FText::FromString("Limit Change"))
-        .NameContent()
-        [
-            SNew(STextBlock)
-                .Text(FText::FromString(TEXT("Limit Change")))
-                .ToolTipText(FText::FromString(TEXT("Global limit change for dynamic behavior tree")))
-        ]
-        .ValueContent()
-        [
-            SNew(SSpinBox<int32>)
-                .ToolTipText(FText::FromString(TEXT("Set limit change value (0-100)")))
-                .MinValue(0)
-                .MaxValue(100)
-                .Value_Lambda([this]() -> int32 {
-                if (CustomizedObjects.Num() == 0) return 0;
-
-                UObject* FirstObj = CustomizedObjects[0].Get();
-                if (!FirstObj) return 0;
-
-                UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
-                int32 FirstVal = DataManager.GetLimitChangeForNode(FirstObj);
-
-                for (int32 i = 1; i < CustomizedObjects.Num(); i++)
-                {
-                    if (UObject* Obj = CustomizedObjects[i].Get())
-                    {
-                        int32 CurrentVal = DataManager.GetLimitChangeForNode(Obj);
-                        if (CurrentVal != FirstVal)
-                        {
-                            return 0;
-                        }
-                    }
-                }
-
-                return FirstVal;
-                    })
-                .OnValueChanged_Lambda([this, &DetailBuilder](int32 NewValue) {
-                UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
-
-                for (TWeakObjectPtr<UObject> ObjPtr : CustomizedObjects)
-                {
-                    if (UObject* Obj = ObjPtr.Get())
-                    {
-                        DataManager.SetLimitChangeForNode(Obj, NewValue);
-
-                        GLog->Logf(ELogVerbosity::Display, TEXT("Root Limit Change for %s set to: %d"), *Obj->GetName(), NewValue);
-                    }
-                }
-
-                for (TWeakObjectPtr<UObject> ObjPtr : CustomizedObjects)
-                {
-                    if (UObject* Obj = ObjPtr.Get())
-                    {
-                        Obj->MarkPackageDirty();
-                    }
-                }
-
-                DetailBuilder.ForceRefreshDetails();
-                    })
-        ];
-}
\ No newline at end of file
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DynamicRootNodeCustomization.h"
+#include "DetailLayoutBuilder.h"
+#include "DetailCategoryBuilder.h"
+#include "DetailWidgetRow.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "ScopedTransaction.h"
+
+TSharedRef<IDetailCustomization> FBehaviorTreeRootNodeCustomization::MakeInstance()
+{
+    return MakeShareable(new FBehaviorTreeRootNodeCustomization);
+}
+
+FBehaviorTreeRootNodeCustomization::~FBehaviorTreeRootNodeCustomization()
+{
+    if (UDBTBehaviorTreeDataManager* DataManager = UDBTBehaviorTreeDataManager::GetIfExists())
+    {
+        DataManager->OnDataRestoredByUndo.Remove(UndoHandle);
+    }
+}
+
+void FBehaviorTreeRootNodeCustomization::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
+{
+    DetailBuilder.GetObjectsBeingCustomized(CustomizedObjects);
+
+    if (CustomizedObjects.Num() == 0)
+        return;
+
+    bool bIsRoot = false;
+    for (auto& Obj : CustomizedObjects)
+    {
+        if (UBTCompositeNode* Node = Cast<UBTCompositeNode>(Obj.Get()))
+        {
+            UBTCompositeNode* ParentNode = Node->GetParentNode();
+            if (ParentNode == nullptr)
+            {
+                bIsRoot = true;
+            }
+            else
+            {
+                bIsRoot = false;
+                break;
+            }
+        }
+    }
+
+    if (!bIsRoot) return;
+
+    UndoHandle = UDBTBehaviorTreeDataManager::Get().OnDataRestoredByUndo.AddRaw(this, &FBehaviorTreeRootNodeCustomization::ResyncFromDataManager);
+
+    ResyncFromDataManager();
+
+    IDetailCategoryBuilder& RootCategory = DetailBuilder.EditCategory(
+        "Root Settings",
+        FText::FromString("Root Settings"),
+        ECategoryPriority::Important
+    );
+
+    RootCategory.AddCustomRow(FText::FromString("Limit Change"))
+        .NameContent()
+        [
+            SNew(STextBlock)
+                .Text(FText::FromString(TEXT("Limit Change")))
+                .ToolTipText(FText::FromString(TEXT("Global limit change for dynamic behavior tree")))
+        ]
+        .ValueContent()
+        [
+            SNew(SSpinBox<int32>)
+                .ToolTipText(FText::FromString(TEXT("Set limit change value (0-100)")))
+                .MinValue(0)
+                .MaxValue(100)
+                .Value_Lambda([this]() -> int32 {
+                return LimitChangeAggregate.Get(0);
+                    })
+                .OnValueChanged_Lambda([this](int32 NewValue) {
+                // Dragging only previews; the data manager is written once when the interaction ends
+                LimitChangeAggregate.Set(NewValue);
+                    })
+                .OnValueCommitted_Lambda([this](int32 NewValue, ETextCommit::Type CommitType) {
+                CommitLimitChange(NewValue);
+                    })
+                .OnEndSliderMovement_Lambda([this](int32 NewValue) {
+                CommitLimitChange(NewValue);
+                    })
+        ];
+}
+
+void FBehaviorTreeRootNodeCustomization::CommitLimitChange(int32 NewValue)
+{
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+
+    TArray<UObject*> Changed = GetObjectsToChange(CustomizedObjects, NewValue, [&DataManager](UObject* Obj) {
+        return DataManager.GetLimitChangeForNode(Obj);
+        });
+
+    LimitChangeAggregate.Set(NewValue);
+    if (Changed.Num() == 0)
+    {
+        return;
+    }
+
+    const FScopedTransaction Transaction(NSLOCTEXT("DBTPluginTest", "SetRootLimitChange", "Set Limit Change"));
+    for (UObject* Obj : Changed)
+    {
+        Obj->Modify();
+    }
+
+    DataManager.SetLimitChangeForNodes(Changed, NewValue);
+}
+
+void FBehaviorTreeRootNodeCustomization::ResyncFromDataManager()
+{
+    LimitChangeAggregate.Recompute(CustomizedObjects, [](UObject* Obj) -> int32 {
+        return UDBTBehaviorTreeDataManager::Get().GetLimitChangeForNode(Obj);
+        });
+}
@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameplayDebuggerCategory_DynamicBehavior.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "DBTDebugTrace.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "AIController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/BTTaskNode.h"
+
+FGameplayDebuggerCategory_DynamicBehavior::FGameplayDebuggerCategory_DynamicBehavior()
+{
+    bShowOnlyWithDebugActor = true;
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_DynamicBehavior::MakeInstance()
+{
+    return MakeShareable(new FGameplayDebuggerCategory_DynamicBehavior());
+}
+
+void FGameplayDebuggerCategory_DynamicBehavior::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+    const APawn* Pawn = Cast<APawn>(DebugActor);
+    const AAIController* AIController = Pawn ? Cast<AAIController>(Pawn->GetController()) : Cast<AAIController>(DebugActor);
+    const UBehaviorTreeComponent* BTComponent = AIController ? Cast<UBehaviorTreeComponent>(AIController->GetBrainComponent()) : nullptr;
+
+    if (StatsOwner != FObjectKey(BTComponent))
+    {
+        Stats.Reset();
+        StatsOwner = FObjectKey(BTComponent);
+    }
+
+    // Fold whatever was sampled since the last collect; the game never waits on this
+    PendingSamples.Reset();
+    TraceCursor = FDBTDebugTrace::Get().ReadSince(TraceCursor, PendingSamples);
+
+    for (const FDBTDebugSample& Sample : PendingSamples)
+    {
+        if (Sample.Owner != StatsOwner)
+        {
+            continue;
+        }
+
+        FCompositeStats& CompositeStats = Stats.FindOrAdd(Sample.Composite);
+        if (Sample.Type == EDBTDebugSampleType::Swap)
+        {
+            CompositeStats.SwapCount++;
+            CompositeStats.LastSwapTime = Sample.Time;
+        }
+        else
+        {
+            CompositeStats.LimitChange = Sample.ValueA;
+            CompositeStats.LastUsageCount = Sample.ValueB;
+        }
+    }
+
+    UBehaviorTree* BehaviorTree = BTComponent ? BTComponent->GetCurrentTree() : nullptr;
+
+    if (!BehaviorTree || !BehaviorTree->RootNode)
+    {
+        AddTextLine(TEXT("{red}No Behavior Tree running"));
+        return;
+    }
+
+    if (!FDBTDebugTrace::IsEnabled())
+    {
+        AddTextLine(TEXT("{yellow}dbt.Debug.Trace is 0, values below are stale"));
+    }
+
+    AddTextLine(FString::Printf(TEXT("Tree: {yellow}%s"), *BehaviorTree->GetName()));
+    CollectComposite(BehaviorTree->RootNode, BTComponent->GetWorld()->GetTimeSeconds());
+}
+
+void FGameplayDebuggerCategory_DynamicBehavior::CollectComposite(UBTCompositeNode* Composite, double Now)
+{
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+
+    bool bHasDynamicChildren = false;
+    FString ChildOrder;
+    for (int32 Index = 0; Index < Composite->Children.Num(); Index++)
+    {
+        const FBTCompositeChild& Child = Composite->Children[Index];
+        if (Child.ChildTask)
+        {
+            const bool bDynamic = DataManager.GetTaskNodeIsDynamic(Child.ChildTask);
+            bHasDynamicChildren |= bDynamic;
+            ChildOrder += FString::Printf(TEXT(" [%d]%s%s"), Index, bDynamic ? TEXT("*") : TEXT(""), *Child.ChildTask->GetNodeName());
+        }
+        else if (Child.ChildComposite)
+        {
+            ChildOrder += FString::Printf(TEXT(" [%d]%s"), Index, *Child.ChildComposite->GetNodeName());
+        }
+    }
+
+    const FCompositeStats* CompositeStats = Stats.Find(FObjectKey(Composite));
+    const bool bHasLimit = DataManager.HasLimitChangeForNode(Composite);
+
+    if (bHasLimit || bHasDynamicChildren || CompositeStats)
+    {
+        FString Line = FString::Printf(TEXT("{white}%s"), *Composite->GetNodeName());
+
+        if (bHasLimit)
+        {
+            const int32 Usage = CompositeStats ? CompositeStats->LastUsageCount : 0;
+            Line += FString::Printf(TEXT("  limit {green}%d{white} usage {green}%d"), DataManager.GetLimitChangeForNode(Composite), Usage);
+        }
+
+        if (CompositeStats && CompositeStats->SwapCount > 0)
+        {
+            Line += FString::Printf(TEXT("{white}  swaps {green}%d{white} last {green}%.1fs{white} ago"), CompositeStats->SwapCount, Now - CompositeStats->LastSwapTime);
+        }
+
+        AddTextLine(Line);
+        AddTextLine(FString::Printf(TEXT("{grey}   order:%s"), *ChildOrder));
+    }
+
+    for (const FBTCompositeChild& Child : Composite->Children)
+    {
+        if (Child.ChildComposite)
+        {
+            CollectComposite(Child.ChildComposite, Now);
+        }
+    }
+}
+#endif
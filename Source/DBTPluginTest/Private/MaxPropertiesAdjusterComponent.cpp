@@ -1,254 +1,350 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "MaxPropertiesAdjusterComponent.h"
-#include "TimerManager.h"
-#include "Engine/World.h"
-#include "GameFramework/PlayerController.h"
-#include "GameFramework/Character.h"
-#include "Misc/FileHelper.h"
-#include "Misc/Paths.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
-#include "Engine/Engine.h"
-#include "DBTBehaviorTreeDataManager.h"
-
-UMaxPropertiesAdjusterComponent::UMaxPropertiesAdjusterComponent()
-{
-	PrimaryComponentTick.bCanEverTick = false;
-}
-
-void UMaxPropertiesAdjusterComponent::BeginPlay()
-{
-	Super::BeginPlay();
-
-	StartAdjustmentTimer();
-}
-
-void UMaxPropertiesAdjusterComponent::StartAdjustmentTimer()
-{
-	if (GetWorld())
-	{
-		UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
-		float DelaySeconds = DataManager.GetGlobalAdjustmentDelay();
-
-		if (!DataManager.IsAnyAIControllerDynamicBehaviorEnabled()) 
-		{ 
-			return;
-		}
-
-		if (DelaySeconds <= 0.0f)
-		{
-			DelaySeconds = 5.0f;
-		}
-
-		GetWorld()->GetTimerManager().SetTimer(
-			AdjustmentTimerHandle,
-			this,
-			&UMaxPropertiesAdjusterComponent::ExecuteAdjustment,
-			DelaySeconds,
-			false
-		);
-
-		GLog->Logf(ELogVerbosity::Display, TEXT("MaxPropertiesAdjusterComponent: Adjustment scheduled in %.1f seconds (from global delay)"), DelaySeconds);
-	}
-}
-
-void UMaxPropertiesAdjusterComponent::ExecuteAdjustment()
-{
-	GLog->Logf(ELogVerbosity::Display, TEXT("MaxPropertiesAdjusterComponent: Starting adjustment..."));
-	ExecuteAdjustmentLogic();
-
-	// StartAdjustmentTimer();
-}
-
-void UMaxPropertiesAdjusterComponent::ExecuteAdjustmentLogic()
-{
-    UWorld* World = GetWorld();
-    if (!World)
-    {
-        GLog->Logf(ELogVerbosity::Warning, TEXT("ExecuteAdjustment: Cannot get World"));
-        return;
-    }
-
-    TArray<APlayerController*> PlayerControllers;
-    for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
-    {
-        APlayerController* PlayerController = Iterator->Get();
-        if (PlayerController)
-        {
-            PlayerControllers.Add(PlayerController);
-        }
-    }
-
-    if (PlayerControllers.Num() == 0)
-    {
-        GLog->Logf(ELogVerbosity::Warning, TEXT("ExecuteAdjustment: No PlayerControllers found in world"));
-        return;
-    }
-
-    GLog->Logf(ELogVerbosity::Display, TEXT("ExecuteAdjustment: Found %d PlayerController(s)"), PlayerControllers.Num());
-
-    FString ConfigFilePath = FPaths::ProjectConfigDir() / TEXT("AIControllerMaxValues.json");
-
-	FString JsonString;
-	if (!FFileHelper::LoadFileToString(JsonString, *ConfigFilePath))
-	{
-		GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: Could not load config file %s"), *ConfigFilePath);
-		return;
-	}
-
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
-	{
-		GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: Could not parse JSON from file %s"), *ConfigFilePath);
-		return;
-	}
-
-	for (APlayerController* PlayerController : PlayerControllers)
-	{
-		APawn* ControlledPawn = PlayerController->GetPawn();
-		if (!ControlledPawn)
-		{
-			GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: PlayerController %s does not control any Pawn"), *PlayerController->GetName());
-			continue;
-		}
-
-		ACharacter* ControlledCharacter = Cast<ACharacter>(ControlledPawn);
-		if (!ControlledCharacter)
-		{
-			GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: PlayerController %s controls pawn that is not ACharacter"), *PlayerController->GetName());
-			continue;
-		}
-
-		GLog->Logf(ELogVerbosity::Display, TEXT("Processing PlayerController: %s, Character: %s"), *PlayerController->GetName(), *ControlledCharacter->GetName());
-
-		UClass* CharacterClass = ControlledCharacter->GetClass();
-
-		TArray<FNumericProperty*> MaxProperties;
-		TArray<double> CurrentValues;
-		TArray<double> FileValues;
-
-		for (UClass* CurrentClass = CharacterClass; CurrentClass; CurrentClass = CurrentClass->GetSuperClass())
-		{
-			for (TFieldIterator<FProperty> PropIt(CurrentClass, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
-			{
-				FProperty* Property = *PropIt;
-				FString PropertyName = Property->GetName();
-
-				if (PropertyName.Contains(TEXT("Max")) && Property->IsA(FNumericProperty::StaticClass()))
-				{
-					FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
-					if (NumericProperty)
-					{
-						bool bAlreadyAdded = false;
-						for (FNumericProperty* AddedProp : MaxProperties)
-						{
-							if (AddedProp->GetFName() == NumericProperty->GetFName())
-							{
-								bAlreadyAdded = true;
-								break;
-							}
-						}
-
-						if (bAlreadyAdded) continue;
-
-						MaxProperties.Add(NumericProperty);
-
-						void* PropertyValuePtr = NumericProperty->ContainerPtrToValuePtr<void>(ControlledCharacter);
-						double CurrentValue = 0.0;
-
-						if (NumericProperty->IsFloatingPoint())
-						{
-							CurrentValue = NumericProperty->GetFloatingPointPropertyValue(PropertyValuePtr);
-						}
-						else if (NumericProperty->IsInteger())
-						{
-							try
-							{
-								CurrentValue = (double)NumericProperty->GetSignedIntPropertyValue(PropertyValuePtr);
-							}
-							catch (...)
-							{
-								CurrentValue = (double)NumericProperty->GetUnsignedIntPropertyValue(PropertyValuePtr);
-							}
-						}
-
-						CurrentValues.Add(CurrentValue);
-
-						double FileValue = 0.0;
-						if (JsonObject->HasField(PropertyName))
-						{
-							FileValue = JsonObject->GetNumberField(PropertyName);
-						}
-						FileValues.Add(FileValue);
-
-						GLog->Logf(ELogVerbosity::Display, TEXT("Found MAX property: %s (from class %s) | Current: %f | File: %f"),
-							*PropertyName, *CurrentClass->GetName(), CurrentValue, FileValue);
-					}
-				}
-			}
-
-			if (CurrentClass == ACharacter::StaticClass())
-			{
-				break;
-			}
-		}
-
-		if (MaxProperties.Num() == 0)
-		{
-			GLog->Logf(ELogVerbosity::Display, TEXT("No MAX properties found in character hierarchy"));
-			continue;
-		}
-
-		double SumDifferences = 0.0;
-		int ValidPropertiesCount = 0;
-
-		for (int32 i = 0; i < MaxProperties.Num(); i++)
-		{
-			double Difference = FMath::Abs(CurrentValues[i] - FileValues[i]);
-			if (FileValues[i] != 0.0)
-			{
-				SumDifferences += Difference;
-				ValidPropertiesCount++;
-			}
-		}
-
-		double Coefficient = 1.0;
-		if (ValidPropertiesCount > 0 && SumDifferences > 0.0)
-		{
-			Coefficient = SumDifferences / ValidPropertiesCount;
-		}
-
-		GLog->Logf(ELogVerbosity::Display, TEXT("Properties found: %d, Valid for calculation: %d"), MaxProperties.Num(), ValidPropertiesCount);
-		GLog->Logf(ELogVerbosity::Display, TEXT("Sum of differences: %f, Coefficient: %f"), SumDifferences, Coefficient);
-
-		for (int32 i = 0; i < MaxProperties.Num(); i++)
-		{
-			FNumericProperty* NumericProperty = MaxProperties[i];
-			FString PropertyName = NumericProperty->GetName();
-
-			void* PropertyValuePtr = NumericProperty->ContainerPtrToValuePtr<void>(ControlledCharacter);
-			double NewValue = CurrentValues[i] * Coefficient;
-
-			if (NumericProperty->IsFloatingPoint())
-			{
-				NumericProperty->SetFloatingPointPropertyValue(PropertyValuePtr, NewValue);
-			}
-			else if (NumericProperty->IsInteger())
-			{
-				int64 IntValue = FMath::RoundToInt(NewValue);
-				NumericProperty->SetIntPropertyValue(PropertyValuePtr, IntValue);
-			}
-
-			GLog->Logf(ELogVerbosity::Display, TEXT("Adjusted %s: %f -> %f"), *PropertyName, CurrentValues[i], NewValue);
-		}
-
-		GLog->Logf(ELogVerbosity::Display, TEXT("PlayerController %s: All MAX properties adjusted by coefficient %f"),
-			*PlayerController->GetName(), Coefficient);
-	}
-
-	GLog->Logf(ELogVerbosity::Display, TEXT("AdjustMaxPropertiesFromConfig: Completed processing all PlayerControllers"));
-
-    GLog->Logf(ELogVerbosity::Display, TEXT("ExecuteAdjustment: Completed"));
-}
\ No newline at end of file
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MaxPropertiesAdjusterComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "AIController.h"
+#include "GameFramework/Character.h"
+#include "Engine/Engine.h"
+#include "Async/Async.h"
+#include "UObject/UObjectIterator.h"
+#include "HAL/IConsoleManager.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "DBTMaxValuesConfig.h"
+#include "DBTMaxPropertyLayout.h"
+#include "DBTMaxPropertiesBatch.h"
+#include "DBTMaxAttributeAdjuster.h"
+#include "DBTAdjusterSubsystem.h"
+
+UMaxPropertiesAdjusterComponent::UMaxPropertiesAdjusterComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMaxPropertiesAdjusterComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	StartAdjustmentTimer();
+}
+
+void UMaxPropertiesAdjusterComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopAdjustmentTimer();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UMaxPropertiesAdjusterComponent::StartAdjustmentTimer()
+{
+	if (GetWorld())
+	{
+		UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+
+		if (!DataManager.IsAnyAIControllerDynamicBehaviorEnabled()) 
+		{ 
+			return;
+		}
+
+		UDBTAdjusterSubsystem* Scheduler = GetWorld()->GetSubsystem<UDBTAdjusterSubsystem>();
+		if (!Scheduler)
+		{
+			return;
+		}
+
+		const float DelaySeconds = Scheduler->RegisterAdjuster(this);
+
+		GLog->Logf(ELogVerbosity::Display, TEXT("MaxPropertiesAdjusterComponent: Adjustment scheduled in %.1f seconds (from global delay)"), DelaySeconds);
+	}
+}
+
+void UMaxPropertiesAdjusterComponent::StopAdjustmentTimer()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UDBTAdjusterSubsystem* Scheduler = World->GetSubsystem<UDBTAdjusterSubsystem>())
+		{
+			Scheduler->UnregisterAdjuster(this);
+		}
+	}
+}
+
+void UMaxPropertiesAdjusterComponent::ExecuteAdjustment()
+{
+	GLog->Logf(ELogVerbosity::Display, TEXT("MaxPropertiesAdjusterComponent: Starting adjustment..."));
+	ExecuteAdjustmentLogic();
+}
+
+void UMaxPropertiesAdjusterComponent::ExecuteAdjustmentLogic()
+{
+	FDBTMaxValuesConfig::FTablePtr Config = FDBTMaxValuesConfig::Get().GetTable();
+	if (!Config.IsValid())
+	{
+		GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: No valid config loaded from %s"), *FDBTMaxValuesConfig::GetConfigFilePath());
+		return;
+	}
+
+	TArray<ACharacter*> Characters;
+	if (GatherAdjustmentTargets(Characters))
+	{
+		AdjustCharacters(Characters, *Config);
+	}
+
+	GLog->Logf(ELogVerbosity::Display, TEXT("ExecuteAdjustment: Completed"));
+}
+
+void UMaxPropertiesAdjusterComponent::PreviewAdjustment()
+{
+	FDBTMaxValuesConfig::FTablePtr Config = FDBTMaxValuesConfig::Get().GetTable();
+	if (!Config.IsValid())
+	{
+		GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: No valid config loaded from %s"), *FDBTMaxValuesConfig::GetConfigFilePath());
+		return;
+	}
+
+	TArray<ACharacter*> Characters;
+	if (!GatherAdjustmentTargets(Characters))
+	{
+		return;
+	}
+
+	const uint32 Serial = ++PreviewSerial;
+	TWeakObjectPtr<UMaxPropertiesAdjusterComponent> WeakThis(this);
+
+	FDBTAdjustmentPreview::ComputeAsync(Characters, Config).Then([WeakThis, Serial](TFuture<FDBTAdjustmentDiffPtr> Result)
+	{
+		FDBTAdjustmentDiffPtr Diff = Result.Get();
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Diff]()
+		{
+			UMaxPropertiesAdjusterComponent* Adjuster = WeakThis.Get();
+			if (!Adjuster || Adjuster->PreviewSerial != Serial)
+			{
+				return;
+			}
+
+			Adjuster->PendingAdjustment = Diff;
+			Diff->DumpToLog();
+			Adjuster->OnPreviewReady.Broadcast(*Diff);
+		});
+	});
+}
+
+int32 UMaxPropertiesAdjusterComponent::CommitPendingAdjustment()
+{
+	if (!PendingAdjustment.IsValid())
+	{
+		GLog->Logf(ELogVerbosity::Warning, TEXT("MaxPropertiesAdjusterComponent: No pending adjustment to commit"));
+		return 0;
+	}
+
+	const int32 AdjustedCount = FDBTAdjustmentPreview::Commit(*PendingAdjustment);
+	DiscardPendingAdjustment();
+
+	GLog->Logf(ELogVerbosity::Display, TEXT("MaxPropertiesAdjusterComponent: Committed pending adjustment to %d character(s)"), AdjustedCount);
+	return AdjustedCount;
+}
+
+void UMaxPropertiesAdjusterComponent::DiscardPendingAdjustment()
+{
+	PendingAdjustment.Reset();
+	PreviewSerial++;
+}
+
+bool UMaxPropertiesAdjusterComponent::GatherAdjustmentTargets(TArray<ACharacter*>& OutCharacters) const
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("ExecuteAdjustment: Cannot get World"));
+        return false;
+    }
+
+    TArray<APlayerController*> PlayerControllers;
+    TArray<AAIController*> AIControllers;
+    for (FConstControllerIterator Iterator = World->GetControllerIterator(); Iterator; ++Iterator)
+    {
+        AController* Controller = Iterator->Get();
+        if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
+        {
+            PlayerControllers.Add(PlayerController);
+        }
+        else if (AAIController* AIController = Cast<AAIController>(Controller))
+        {
+            if (bAdjustAIControllers && IsDynamicBehaviorController(AIController))
+            {
+                AIControllers.Add(AIController);
+            }
+        }
+    }
+
+    if (PlayerControllers.Num() == 0 && AIControllers.Num() == 0)
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("ExecuteAdjustment: No PlayerControllers or dynamic AIControllers found in world"));
+        return false;
+    }
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("ExecuteAdjustment: Found %d PlayerController(s) and %d dynamic AIController(s)"), PlayerControllers.Num(), AIControllers.Num());
+
+	for (APlayerController* PlayerController : PlayerControllers)
+	{
+		APawn* ControlledPawn = PlayerController->GetPawn();
+		if (!ControlledPawn)
+		{
+			GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: PlayerController %s does not control any Pawn"), *PlayerController->GetName());
+			continue;
+		}
+
+		ACharacter* ControlledCharacter = Cast<ACharacter>(ControlledPawn);
+		if (!ControlledCharacter)
+		{
+			GLog->Logf(ELogVerbosity::Warning, TEXT("AdjustMaxPropertiesFromConfig: PlayerController %s controls pawn that is not ACharacter"), *PlayerController->GetName());
+			continue;
+		}
+
+		OutCharacters.Add(ControlledCharacter);
+	}
+
+	// AI controllers without a character pawn are common (spectating, between possessions) and skipped silently
+	for (AAIController* AIController : AIControllers)
+	{
+		if (ACharacter* ControlledCharacter = Cast<ACharacter>(AIController->GetPawn()))
+		{
+			OutCharacters.Add(ControlledCharacter);
+		}
+	}
+
+	return OutCharacters.Num() > 0;
+}
+
+bool UMaxPropertiesAdjusterComponent::IsDynamicBehaviorController(AAIController* AIController)
+{
+	// The flag is usually set in the editor on the archetype the runtime controller was spawned from
+	UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+	return DataManager.GetAIControllerDynamicBehaviorFlag(AIController)
+		|| DataManager.GetAIControllerDynamicBehaviorFlag(AIController->GetArchetype())
+		|| DataManager.GetAIControllerDynamicBehaviorFlag(AIController->GetClass()->GetDefaultObject());
+}
+
+void UMaxPropertiesAdjusterComponent::AdjustCharacters(const TArray<ACharacter*>& Characters, const FDBTMaxValuesTable& Config) const
+{
+	TArray<ACharacter*> BatchCharacters;
+
+	for (ACharacter* Character : Characters)
+	{
+		// Characters with Max gameplay attributes are adjusted through their ASC only
+		if (FDBTMaxAttributeAdjuster::Get().AdjustActor(Character, Config))
+		{
+			continue;
+		}
+
+		if (bUseBatchAdjustment)
+		{
+			BatchCharacters.Add(Character);
+			continue;
+		}
+
+		AdjustCharacter(Character, Config);
+	}
+
+	if (BatchCharacters.Num() > 0)
+	{
+		const int32 AdjustedCount = FDBTMaxPropertiesBatch::AdjustCharacters(BatchCharacters, Config);
+		GLog->Logf(ELogVerbosity::Display, TEXT("AdjustMaxPropertiesFromConfig: %d character(s) adjusted in batch mode"), AdjustedCount);
+	}
+}
+
+void UMaxPropertiesAdjusterComponent::AdjustCharacter(ACharacter* Character, const FDBTMaxValuesTable& Config) const
+{
+	GLog->Logf(ELogVerbosity::Display, TEXT("Processing Character: %s"), *Character->GetName());
+
+	FDBTMaxPropertyLayoutRef Layout = FDBTMaxPropertyLayoutCache::Get().GetLayout(Character->GetClass());
+	const TArray<FDBTMaxPropertyEntry>& MaxProperties = Layout->Properties;
+
+	if (MaxProperties.Num() == 0)
+	{
+		GLog->Logf(ELogVerbosity::Display, TEXT("No MAX properties found in character hierarchy"));
+		return;
+	}
+
+	TArray<double> CurrentValues;
+	TArray<double> FileValues;
+	CurrentValues.SetNumUninitialized(MaxProperties.Num());
+	FileValues.SetNumUninitialized(MaxProperties.Num());
+
+	for (int32 i = 0; i < MaxProperties.Num(); i++)
+	{
+		CurrentValues[i] = FDBTMaxPropertyLayout::ReadValue(Character, MaxProperties[i]);
+		FileValues[i] = Config.GetValue(MaxProperties[i].Name);
+
+		GLog->Logf(ELogVerbosity::Display, TEXT("Found MAX property: %s (from class %s) | Current: %f | File: %f"),
+			*MaxProperties[i].Name.ToString(), *MaxProperties[i].DeclaringClassName.ToString(), CurrentValues[i], FileValues[i]);
+	}
+
+	double SumDifferences = 0.0;
+	int ValidPropertiesCount = 0;
+
+	for (int32 i = 0; i < MaxProperties.Num(); i++)
+	{
+		double Difference = FMath::Abs(CurrentValues[i] - FileValues[i]);
+		if (FileValues[i] != 0.0)
+		{
+			SumDifferences += Difference;
+			ValidPropertiesCount++;
+		}
+	}
+
+	double Coefficient = 1.0;
+	if (ValidPropertiesCount > 0 && SumDifferences > 0.0)
+	{
+		Coefficient = SumDifferences / ValidPropertiesCount;
+	}
+
+	GLog->Logf(ELogVerbosity::Display, TEXT("Properties found: %d, Valid for calculation: %d"), MaxProperties.Num(), ValidPropertiesCount);
+	GLog->Logf(ELogVerbosity::Display, TEXT("Sum of differences: %f, Coefficient: %f"), SumDifferences, Coefficient);
+
+	for (int32 i = 0; i < MaxProperties.Num(); i++)
+	{
+		double NewValue = CurrentValues[i] * Coefficient;
+		FDBTMaxPropertyLayout::WriteValue(Character, MaxProperties[i], NewValue);
+
+		GLog->Logf(ELogVerbosity::Display, TEXT("Adjusted %s: %f -> %f"), *MaxProperties[i].Name.ToString(), CurrentValues[i], NewValue);
+	}
+
+	GLog->Logf(ELogVerbosity::Display, TEXT("Character %s: All MAX properties adjusted by coefficient %f"),
+		*Character->GetName(), Coefficient);
+}
+
+static void ForEachAdjusterInWorld(UWorld* World, TFunctionRef<void(UMaxPropertiesAdjusterComponent&)> Callback)
+{
+	for (TObjectIterator<UMaxPropertiesAdjusterComponent> It; It; ++It)
+	{
+		if (It->GetWorld() == World && !It->IsTemplate())
+		{
+			Callback(**It);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorld DBTAdjusterPreviewCommand(
+	TEXT("dbt.Adjuster.Preview"),
+	TEXT("Computes and logs what every max properties adjuster would change, without applying it."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		ForEachAdjusterInWorld(World, [](UMaxPropertiesAdjusterComponent& Adjuster) { Adjuster.PreviewAdjustment(); });
+	}));
+
+static FAutoConsoleCommandWithWorld DBTAdjusterCommitCommand(
+	TEXT("dbt.Adjuster.Commit"),
+	TEXT("Applies the pending previews of every max properties adjuster."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		ForEachAdjusterInWorld(World, [](UMaxPropertiesAdjusterComponent& Adjuster) { Adjuster.CommitPendingAdjustment(); });
+	}));
+
+static FAutoConsoleCommandWithWorld DBTAdjusterDiscardCommand(
+	TEXT("dbt.Adjuster.Discard"),
+	TEXT("Drops the pending previews of every max properties adjuster."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		ForEachAdjusterInWorld(World, [](UMaxPropertiesAdjusterComponent& Adjuster) { Adjuster.DiscardPendingAdjustment(); });
+	}));
@@ -0,0 +1,506 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SDBTDynamicBehaviorBrowser.h"
+
+#if WITH_EDITOR
+#include "DBTAssetRegistryTags.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "DBTBehaviorTreeIndex.h"
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BTNode.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "AIGraphNode.h"
+#include "EdGraph/EdGraph.h"
+#include "GraphEditor.h"
+#include "Toolkits/AssetEditorToolkit.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Editor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Framework/Docking/TabManager.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+#include "EditorStyleSet.h"
+
+#define LOCTEXT_NAMESPACE "DBTDynamicBehaviorBrowser"
+
+const FName SDBTDynamicBehaviorBrowser::TabName(TEXT("DBTDynamicBehaviorBrowser"));
+
+namespace DBTBrowserColumns
+{
+    static const FName Kind(TEXT("Kind"));
+    static const FName Name(TEXT("Name"));
+    static const FName Category(TEXT("Category"));
+    static const FName Tree(TEXT("Tree"));
+    static const FName Value(TEXT("Value"));
+}
+
+static FText GetRowKindText(EDBTBrowserRowKind Kind)
+{
+    switch (Kind)
+    {
+    case EDBTBrowserRowKind::BehaviorTree:   return LOCTEXT("KindTree", "Behavior Tree");
+    case EDBTBrowserRowKind::DynamicTask:    return LOCTEXT("KindTask", "Dynamic Task");
+    case EDBTBrowserRowKind::CompositeLimit: return LOCTEXT("KindLimit", "Composite Limit");
+    case EDBTBrowserRowKind::AIController:   return LOCTEXT("KindController", "AI Controller");
+    default:                                 return FText::GetEmpty();
+    }
+}
+
+class SDBTBrowserTableRow : public SMultiColumnTableRow<FDBTBrowserRowPtr>
+{
+public:
+    SLATE_BEGIN_ARGS(SDBTBrowserTableRow) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, FDBTBrowserRowPtr InRow)
+    {
+        Row = InRow;
+        SMultiColumnTableRow<FDBTBrowserRowPtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+    }
+
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        FText Text;
+        if (ColumnName == DBTBrowserColumns::Kind)          Text = GetRowKindText(Row->Kind);
+        else if (ColumnName == DBTBrowserColumns::Name)     Text = FText::FromString(Row->Name);
+        else if (ColumnName == DBTBrowserColumns::Category) Text = FText::FromString(Row->Category);
+        else if (ColumnName == DBTBrowserColumns::Tree)     Text = FText::FromString(Row->Tree);
+        else if (ColumnName == DBTBrowserColumns::Value)    Text = FText::AsNumber(Row->Value);
+
+        return SNew(STextBlock).Text(Text);
+    }
+
+private:
+    FDBTBrowserRowPtr Row;
+};
+
+void SDBTDynamicBehaviorBrowser::RegisterTabSpawner()
+{
+    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(TabName, FOnSpawnTab::CreateLambda([](const FSpawnTabArgs& Args)
+    {
+        return SNew(SDockTab)
+            .TabRole(ETabRole::NomadTab)
+            [
+                SNew(SDBTDynamicBehaviorBrowser)
+            ];
+    }))
+        .SetDisplayName(LOCTEXT("TabTitle", "Dynamic Behavior"))
+        .SetTooltipText(LOCTEXT("TabTooltip", "Browse dynamic task nodes, composite limits and AI controllers across the project"))
+        .SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void SDBTDynamicBehaviorBrowser::UnregisterTabSpawner()
+{
+    FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(TabName);
+}
+
+void SDBTDynamicBehaviorBrowser::Construct(const FArguments& InArgs)
+{
+    CategoryFilterOptions.Add(MakeShared<FString>(TEXT("All Categories")));
+    CategoryFilterOptions.Add(MakeShared<FString>(TEXT("Offensive Action")));
+    CategoryFilterOptions.Add(MakeShared<FString>(TEXT("Defensive Action")));
+    CategoryFilterOptions.Add(MakeShared<FString>(TEXT("Supporting Action")));
+    CategoryFilter = CategoryFilterOptions[0];
+
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(2.0f)
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            [
+                SNew(SSearchBox)
+                .HintText(LOCTEXT("TreeFilterHint", "Filter by tree"))
+                .OnTextChanged_Lambda([this](const FText& Text)
+                {
+                    TreeFilter = Text.ToString();
+                    ApplyFilters();
+                })
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(4.0f, 0.0f)
+            [
+                SNew(SComboBox<TSharedPtr<FString>>)
+                .OptionsSource(&CategoryFilterOptions)
+                .OnGenerateWidget_Lambda([](TSharedPtr<FString> Item) -> TSharedRef<SWidget>
+                {
+                    return SNew(STextBlock).Text(FText::FromString(*Item));
+                })
+                .OnSelectionChanged_Lambda([this](TSharedPtr<FString> NewValue, ESelectInfo::Type SelectType)
+                {
+                    if (NewValue.IsValid())
+                    {
+                        CategoryFilter = NewValue;
+                        ApplyFilters();
+                    }
+                })
+                .Content()
+                [
+                    SNew(STextBlock).Text_Lambda([this]() { return FText::FromString(*CategoryFilter); })
+                ]
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SButton)
+                .Text(LOCTEXT("Refresh", "Refresh"))
+                .OnClicked_Lambda([this]()
+                {
+                    RebuildRows();
+                    return FReply::Handled();
+                })
+            ]
+        ]
+        + SVerticalBox::Slot()
+        .FillHeight(1.0f)
+        [
+            SNew(SBorder)
+            .BorderImage(FEditorStyle::GetBrush("ToolPanel.GroupBorder"))
+            [
+                SAssignNew(ListView, SListView<FDBTBrowserRowPtr>)
+                .ListItemsSource(&FilteredRows)
+                .SelectionMode(ESelectionMode::Single)
+                .OnGenerateRow(this, &SDBTDynamicBehaviorBrowser::OnGenerateRow)
+                .OnMouseButtonDoubleClick(this, &SDBTDynamicBehaviorBrowser::OnRowDoubleClicked)
+                .HeaderRow
+                (
+                    SNew(SHeaderRow)
+                    + SHeaderRow::Column(DBTBrowserColumns::Kind).DefaultLabel(LOCTEXT("KindColumn", "Kind")).FillWidth(0.15f)
+                    + SHeaderRow::Column(DBTBrowserColumns::Name).DefaultLabel(LOCTEXT("NameColumn", "Name")).FillWidth(0.25f)
+                    + SHeaderRow::Column(DBTBrowserColumns::Category).DefaultLabel(LOCTEXT("CategoryColumn", "Category")).FillWidth(0.2f)
+                    + SHeaderRow::Column(DBTBrowserColumns::Tree).DefaultLabel(LOCTEXT("TreeColumn", "Tree")).FillWidth(0.3f)
+                    + SHeaderRow::Column(DBTBrowserColumns::Value).DefaultLabel(LOCTEXT("ValueColumn", "Count / Limit")).FillWidth(0.1f)
+                )
+            ]
+        ]
+    ];
+
+    RebuildRows();
+}
+
+void SDBTDynamicBehaviorBrowser::RebuildRows()
+{
+    AllRows.Reset();
+
+    auto AddRow = [this](EDBTBrowserRowKind Kind, const FString& Name, const FSoftObjectPath& AssetPath) -> FDBTBrowserRow&
+    {
+        FDBTBrowserRowPtr Row = MakeShared<FDBTBrowserRow>();
+        Row->Kind = Kind;
+        Row->Name = Name;
+        Row->AssetPath = AssetPath;
+        AllRows.Add(Row);
+        return *Row;
+    };
+
+    // Unloaded assets come from their registry tags; loaded ones from the data manager below,
+    // so unsaved edits show up too
+    TArray<TPair<FAssetData, FDBTBehaviorTreeSummary>> Trees;
+    FDBTAssetRegistryTags::FindBehaviorTrees(Trees, false);
+    for (const TPair<FAssetData, FDBTBehaviorTreeSummary>& Tree : Trees)
+    {
+        const FString TreeName = Tree.Key.AssetName.ToString();
+        const FSoftObjectPath AssetPath = Tree.Key.ToSoftObjectPath();
+        const UBehaviorTree* LoadedTree = Cast<UBehaviorTree>(Tree.Key.FastGetAsset(false));
+
+        const FDBTBehaviorTreeSummary Summary = LoadedTree ? FDBTBehaviorTreeSummary::FromBehaviorTree(LoadedTree) : Tree.Value;
+        if (!Summary.HasDynamicData())
+        {
+            continue;
+        }
+
+        FDBTBrowserRow& TreeRow = AddRow(EDBTBrowserRowKind::BehaviorTree, TreeName, AssetPath);
+        TreeRow.Category = FString::Join(Summary.Categories, TEXT(", "));
+        TreeRow.Tree = TreeName;
+        TreeRow.Value = Summary.DynamicNodeCount;
+
+        if (LoadedTree)
+        {
+            continue;
+        }
+
+        const FDBTBehaviorTreeIndex Index = FDBTBehaviorTreeIndex::FromAssetData(Tree.Key);
+        for (const FDBTBehaviorTreeIndex::FTaskEntry& Entry : Index.DynamicTasks)
+        {
+            FDBTBrowserRow& Row = AddRow(EDBTBrowserRowKind::DynamicTask, Entry.NodeName.ToString(), AssetPath);
+            Row.Category = Entry.Category;
+            Row.Tree = TreeName;
+        }
+
+        for (const TPair<FName, int32>& Limit : Index.LimitChanges)
+        {
+            FDBTBrowserRow& Row = AddRow(EDBTBrowserRowKind::CompositeLimit, Limit.Key.ToString(), AssetPath);
+            Row.Tree = TreeName;
+            Row.Value = Limit.Value;
+        }
+    }
+
+    TArray<FAssetData> ControllerAssets;
+    FDBTAssetRegistryTags::FindControllerAssets(ControllerAssets);
+    for (const FAssetData& AssetData : ControllerAssets)
+    {
+        if (AssetData.IsAssetLoaded())
+        {
+            continue;
+        }
+
+        TArray<FDBTTaggedEntry> Entries;
+        FDBTAssetRegistryTags::ReadEntries(AssetData, FDBTAssetRegistryTags::DynamicControllersTag, Entries);
+        for (const FDBTTaggedEntry& Entry : Entries)
+        {
+            bool bDynamic = false;
+            int32 TimeLimit = 0;
+            if (FDBTAssetRegistryTags::ParseControllerEntry(Entry, bDynamic, TimeLimit) && bDynamic)
+            {
+                AddRow(EDBTBrowserRowKind::AIController, Entry.Name, AssetData.ToSoftObjectPath()).Value = TimeLimit;
+            }
+        }
+    }
+
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+
+    auto MakeObjectRow = [&AddRow](EDBTBrowserRowKind Kind, UObject* Object) -> FDBTBrowserRow&
+    {
+        FDBTBrowserRow& Row = AddRow(Kind, Object->GetName(), FSoftObjectPath(Object->GetOutermost()));
+        Row.Object = Object;
+
+        if (const UBTNode* Node = Cast<UBTNode>(Object))
+        {
+            if (const UBehaviorTree* TreeAsset = Cast<UBehaviorTree>(Node->GetOuter()))
+            {
+                Row.Tree = TreeAsset->GetName();
+                Row.AssetPath = FSoftObjectPath(TreeAsset);
+            }
+        }
+
+        return Row;
+    };
+
+    for (const auto& Pair : DataManager.GetAllTaskNodeDynamicFlags())
+    {
+        if (UObject* Node = Pair.Key.Get())
+        {
+            if (Pair.Value)
+            {
+                MakeObjectRow(EDBTBrowserRowKind::DynamicTask, Node).Category = DataManager.GetTaskNodeCategory(Node);
+            }
+        }
+    }
+
+    for (const auto& Pair : DataManager.GetAllLimitChanges())
+    {
+        if (UObject* Node = Pair.Key.Get())
+        {
+            MakeObjectRow(EDBTBrowserRowKind::CompositeLimit, Node).Value = Pair.Value;
+        }
+    }
+
+    for (const auto& Pair : DataManager.GetAllAIControllerDynamicBehaviorFlags())
+    {
+        if (UObject* Controller = Pair.Key.Get())
+        {
+            if (Pair.Value)
+            {
+                MakeObjectRow(EDBTBrowserRowKind::AIController, Controller).Value = DataManager.GetAIControllerTimeLimit(Controller);
+            }
+        }
+    }
+
+    ApplyFilters();
+}
+
+void SDBTDynamicBehaviorBrowser::ApplyFilters()
+{
+    const bool bFilterCategory = CategoryFilter != CategoryFilterOptions[0];
+
+    FilteredRows.Reset();
+    for (const FDBTBrowserRowPtr& Row : AllRows)
+    {
+        if (bFilterCategory && !Row->Category.Contains(*CategoryFilter))
+        {
+            continue;
+        }
+
+        if (!TreeFilter.IsEmpty() && !Row->Tree.Contains(TreeFilter))
+        {
+            continue;
+        }
+
+        FilteredRows.Add(Row);
+    }
+
+    if (ListView.IsValid())
+    {
+        ListView->RequestListRefresh();
+    }
+}
+
+TSharedRef<ITableRow> SDBTDynamicBehaviorBrowser::OnGenerateRow(FDBTBrowserRowPtr Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(SDBTBrowserTableRow, OwnerTable, Row);
+}
+
+static UBTNode* FindNodeByName(UBTCompositeNode* Composite, FName NodeName)
+{
+    if (Composite->GetFName() == NodeName)
+    {
+        return Composite;
+    }
+
+    for (const FBTCompositeChild& Child : Composite->Children)
+    {
+        if (Child.ChildComposite)
+        {
+            if (UBTNode* Found = FindNodeByName(Child.ChildComposite, NodeName))
+            {
+                return Found;
+            }
+        }
+        else if (Child.ChildTask && Child.ChildTask->GetFName() == NodeName)
+        {
+            return Child.ChildTask;
+        }
+    }
+    return nullptr;
+}
+
+static TSharedPtr<SGraphEditor> FindGraphEditor(const TSharedRef<SWidget>& Widget, const UEdGraph* Graph)
+{
+    static const FName GraphEditorType(TEXT("SGraphEditor"));
+    if (Widget->GetType() == GraphEditorType)
+    {
+        TSharedRef<SGraphEditor> GraphEditor = StaticCastSharedRef<SGraphEditor>(Widget);
+        if (GraphEditor->GetCurrentGraph() == Graph)
+        {
+            return GraphEditor;
+        }
+    }
+
+    FChildren* Children = Widget->GetChildren();
+    for (int32 ChildIndex = 0; ChildIndex < Children->Num(); ChildIndex++)
+    {
+        if (TSharedPtr<SGraphEditor> Found = FindGraphEditor(Children->GetChildAt(ChildIndex), Graph))
+        {
+            return Found;
+        }
+    }
+    return nullptr;
+}
+
+// The Behavior Tree editor has no public API to jump to a node, so its graph widget is looked up
+static void FocusBehaviorTreeNode(UBehaviorTree* BehaviorTree, const UBTNode* Node)
+{
+    UEdGraph* Graph = BehaviorTree->BTGraph;
+    if (!Graph)
+    {
+        return;
+    }
+
+    UEdGraphNode* const* GraphNode = Graph->Nodes.FindByPredicate([Node](const UEdGraphNode* Candidate)
+    {
+        const UAIGraphNode* AIGraphNode = Cast<UAIGraphNode>(Candidate);
+        return AIGraphNode && AIGraphNode->NodeInstance == Node;
+    });
+    if (!GraphNode)
+    {
+        return;
+    }
+
+    IAssetEditorInstance* Editor = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->FindEditorForAsset(BehaviorTree, true);
+    TSharedPtr<FTabManager> TabManager = Editor ? static_cast<FAssetEditorToolkit*>(Editor)->GetTabManager() : nullptr;
+    TSharedPtr<SDockTab> OwnerTab = TabManager.IsValid() ? TabManager->GetOwnerTab() : nullptr;
+    if (!OwnerTab.IsValid())
+    {
+        return;
+    }
+
+    if (TSharedPtr<SGraphEditor> GraphEditor = FindGraphEditor(OwnerTab->GetContent(), Graph))
+    {
+        GraphEditor->JumpToNode(*GraphNode, false, true);
+    }
+}
+
+void SDBTDynamicBehaviorBrowser::OnRowDoubleClicked(FDBTBrowserRowPtr Row)
+{
+    if (!Row.IsValid() || !GEditor)
+    {
+        return;
+    }
+
+    // Controllers placed in a level are selected there instead of opening the map
+    if (AActor* Actor = Cast<AActor>(Row->Object.Get()))
+    {
+        if (!Actor->IsTemplate())
+        {
+            GEditor->SelectNone(false, true);
+            GEditor->SelectActor(Actor, true, true);
+            GEditor->MoveViewportCamerasToActor(*Actor, false);
+            return;
+        }
+    }
+
+    UObject* Asset = nullptr;
+    UObject* Object = Row->Object.Get();
+    if (Object && Object->HasAnyFlags(RF_ClassDefaultObject))
+    {
+        // Class default objects open their Blueprint
+        Asset = Object->GetClass()->ClassGeneratedBy;
+    }
+
+    if (!Asset)
+    {
+        Asset = Row->AssetPath.TryLoad();
+    }
+
+    if (!Asset)
+    {
+        return;
+    }
+
+    GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(Asset);
+
+    // Node rows of unloaded trees only know the node name until the tree is loaded
+    if (UBehaviorTree* BehaviorTree = Cast<UBehaviorTree>(Asset))
+    {
+        const UBTNode* Node = Cast<UBTNode>(Row->Object.Get());
+        if (!Node && Row->Kind != EDBTBrowserRowKind::BehaviorTree && BehaviorTree->RootNode)
+        {
+            Node = FindNodeByName(BehaviorTree->RootNode, FName(*Row->Name));
+        }
+
+        if (Node)
+        {
+            FocusBehaviorTreeNode(BehaviorTree, Node);
+        }
+        return;
+    }
+
+    // Opening a map asset loads it as the editor world; select the controller placed in it
+    if (Row->Kind == EDBTBrowserRowKind::AIController && Asset->IsA<UWorld>())
+    {
+        UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+        AActor* Actor = EditorWorld && EditorWorld->PersistentLevel ? FindObject<AActor>(EditorWorld->PersistentLevel, *Row->Name) : nullptr;
+        if (Actor)
+        {
+            GEditor->SelectNone(false, true);
+            GEditor->SelectActor(Actor, true, true);
+            GEditor->MoveViewportCamerasToActor(*Actor, false);
+        }
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
+#endif
@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTBehaviorTreeGenerator.h"
+#include "DBTBehaviorTreeDataManager.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BTCompositeNode.h"
+#include "BehaviorTree/Tasks/BTTask_Wait.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Node classes, wait times and data manager metadata in tree order; object names are unique per tree and left out
+static void DescribeComposite(UBTCompositeNode* Composite, FString& OutDescription, TArray<UObject*>& OutNodes)
+{
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+    OutNodes.Add(Composite);
+
+    OutDescription += Composite->GetClass()->GetName();
+    if (DataManager.HasLimitChangeForNode(Composite))
+    {
+        OutDescription += FString::Printf(TEXT(" limit=%d"), DataManager.GetLimitChangeForNode(Composite));
+    }
+    OutDescription += TEXT(" (");
+
+    for (const FBTCompositeChild& Child : Composite->Children)
+    {
+        if (Child.ChildComposite)
+        {
+            DescribeComposite(Child.ChildComposite, OutDescription, OutNodes);
+        }
+        else if (const UBTTask_Wait* Task = Cast<UBTTask_Wait>(Child.ChildTask))
+        {
+            OutNodes.Add(Child.ChildTask);
+            OutDescription += FString::Printf(TEXT("Wait %.4f"), Task->WaitTime);
+            if (DataManager.GetTaskNodeIsDynamic(Child.ChildTask))
+            {
+                OutDescription += FString::Printf(TEXT(" dynamic=%s"), *DataManager.GetTaskNodeCategory(Child.ChildTask));
+            }
+        }
+        OutDescription += TEXT(", ");
+    }
+
+    OutDescription += TEXT(")");
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDBTBehaviorTreeGeneratorTest, "DBTPluginTest.Generator.ReproducibleFromSeed",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FDBTBehaviorTreeGeneratorTest::RunTest(const FString& Parameters)
+{
+    FDBTBehaviorTreeGeneratorParams Params;
+    Params.Depth = 4;
+    Params.FanOut = 5;
+    Params.Seed = 1234;
+    Params.NonRootLimitChangeFraction = 0.25f;
+
+    FDBTGeneratedBehaviorTree First = FDBTBehaviorTreeGenerator::Generate(Params);
+    FDBTGeneratedBehaviorTree Second = FDBTBehaviorTreeGenerator::Generate(Params);
+
+    FString FirstDescription;
+    FString SecondDescription;
+    TArray<UObject*> FirstNodes;
+    TArray<UObject*> SecondNodes;
+    DescribeComposite(First.Tree->RootNode, FirstDescription, FirstNodes);
+    DescribeComposite(Second.Tree->RootNode, SecondDescription, SecondNodes);
+
+    TestEqual(TEXT("Same params and seed give the same tree"), FirstDescription, SecondDescription);
+    TestEqual(TEXT("Same composite count"), First.NumComposites, Second.NumComposites);
+    TestEqual(TEXT("Same task count"), First.NumTasks, Second.NumTasks);
+    TestEqual(TEXT("Same dynamic task count"), First.NumDynamicTasks, Second.NumDynamicTasks);
+    TestEqual(TEXT("Counts match the nodes in the tree"), First.NumComposites + First.NumTasks, FirstNodes.Num());
+
+    FDBTBehaviorTreeGeneratorParams CappedParams = Params;
+    CappedParams.Depth = 6;
+    CappedParams.FanOut = 8;
+    CappedParams.MaxNodes = 200;
+    {
+        FDBTGeneratedBehaviorTree Capped = FDBTBehaviorTreeGenerator::Generate(CappedParams);
+
+        FString Description;
+        TArray<UObject*> Nodes;
+        DescribeComposite(Capped.Tree->RootNode, Description, Nodes);
+
+        TestTrue(FString::Printf(TEXT("MaxNodes caps the tree at %d nodes, got %d"), CappedParams.MaxNodes, Nodes.Num()), Nodes.Num() <= CappedParams.MaxNodes);
+        TestEqual(TEXT("Capped counts match the nodes in the tree"), Capped.NumComposites + Capped.NumTasks, Nodes.Num());
+    }
+
+    // The tree stays referenced so its nodes can still be looked up after the release
+    TStrongObjectPtr<UBehaviorTree> KeptTree(First.Tree.Get());
+    First.Reset();
+
+    UDBTBehaviorTreeDataManager& DataManager = UDBTBehaviorTreeDataManager::Get();
+    const bool bAnyNodeLeft = FirstNodes.ContainsByPredicate([&DataManager](UObject* Node)
+    {
+        return DataManager.HasLimitChangeForNode(Node) || DataManager.GetTaskNodeIsDynamic(Node);
+    });
+    TestFalse(TEXT("Reset removes the generated nodes from the data manager"), bAnyNodeLeft);
+    TestFalse(TEXT("Reset releases the tree"), First.Tree.IsValid());
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTPluginTest.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Total time all startup stages should take; each stage runs in its own tick, so this bounds the worst hitch
+static constexpr double DBTStartupStagesBudgetSeconds = 0.05;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDBTStartupStagesBudgetTest, "DBTPluginTest.Startup.StagesWithinBudget",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FDBTStartupStagesBudgetTest::RunTest(const FString& Parameters)
+{
+    const FDBTPluginTestModule& Module = FModuleManager::GetModuleChecked<FDBTPluginTestModule>("DBTPluginTest");
+
+    // Reports the times measured when the stages ran at startup; running them again would tear
+    // down registrations under open editor panels
+    if (Module.HasPendingStartupStages())
+    {
+        AddInfo(TEXT("Deferred startup has not finished yet; only completed stages are reported"));
+    }
+
+    double TotalSeconds = 0.0;
+    for (const FDBTPluginTestModule::FStartupStageTiming& Timing : Module.GetStartupStageTimings())
+    {
+        AddInfo(FString::Printf(TEXT("Startup stage %s took %.2f ms"), Timing.Name, Timing.Seconds * 1000.0));
+        TotalSeconds += Timing.Seconds;
+    }
+
+    // Wall-clock times vary on shared machines, so going over the budget only warns
+    if (TotalSeconds > DBTStartupStagesBudgetSeconds)
+    {
+        AddWarning(FString::Printf(TEXT("Startup stages took %.2f ms, budget is %.2f ms"), TotalSeconds * 1000.0, DBTStartupStagesBudgetSeconds * 1000.0));
+    }
+
+    return true;
+}
+
+#endif
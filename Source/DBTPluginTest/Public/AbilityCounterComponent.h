@@ -1,54 +1,179 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Components/ActorComponent.h"
-#include "AbilitySystemInterface.h"
-#include "Abilities/GameplayAbility.h"
-#include "AbilityCounterComponent.generated.h"
-
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAbilityUsedSignature, const FString&, AbilityName, int32, UsageCount);
-
-UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
-class DBTPLUGINTEST_API UAbilityCounterComponent : public UActorComponent
-{
-    GENERATED_BODY()
-
-public:
-    UAbilityCounterComponent();
-
-    UPROPERTY(BlueprintAssignable, Category = "Ability Counter")
-    FOnAbilityUsedSignature OnAbilityUsed;
-
-    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
-    int32 GetAbilityUsageCount(TSubclassOf<class UGameplayAbility> AbilityClass) const;
-
-    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
-    int32 GetAbilityUsageCountByName(const FString& AbilityClassName) const;
-
-    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
-    TMap<FString, int32> GetAllAbilityUsageStats() const;
-
-    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
-    void ResetAllCounters();
-
-    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
-    void PrintStats() const;
-
-    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
-    void DisplayStatsOnScreen(float Duration = 5.0f) const;
-
-    UFUNCTION(Exec)
-    void ShowAbilityStats();
-
-    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
-    void IncrementAbilityCounter(const FString& AbilityName);
-
-protected:
-    virtual void BeginPlay() override;
-
-private:
-    UPROPERTY()
-    TMap<FString, int32> AbilityUsageMap;
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AbilitySystemInterface.h"
+#include "Abilities/GameplayAbility.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "AbilityCategoryUtils.h"
+#include "AbilityCounterComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAbilityUsedSignature, const FString&, AbilityName, int32, UsageCount);
+
+class UAbilityCounterComponent;
+struct FAbilityUsageArray;
+
+USTRUCT(BlueprintType)
+struct DBTPLUGINTEST_API FAbilityUsageEntry : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    static constexpr uint8 NoCategory = 0xFF;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Ability Counter")
+    FString AbilityName;
+
+    // Uses since WriteStamp; only counts if no reset happened after that stamp
+    UPROPERTY(BlueprintReadOnly, Category = "Ability Counter")
+    int32 UsageCount = 0;
+
+    // Uses since the component was created, never reset
+    UPROPERTY(BlueprintReadOnly, Category = "Ability Counter")
+    int32 LifetimeUsageCount = 0;
+
+    UPROPERTY()
+    uint8 Category = NoCategory;
+
+    UPROPERTY()
+    uint32 WriteStamp = 0;
+
+    UPROPERTY()
+    uint32 ResetStamp = 0;
+
+    void PostReplicatedAdd(const FAbilityUsageArray& InArraySerializer);
+    void PostReplicatedChange(const FAbilityUsageArray& InArraySerializer);
+    void PreReplicatedRemove(const FAbilityUsageArray& InArraySerializer);
+};
+
+// Only entries that changed since the last ack are sent to each connection
+USTRUCT()
+struct DBTPLUGINTEST_API FAbilityUsageArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FAbilityUsageEntry> Items;
+
+    UAbilityCounterComponent* OwnerComponent = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FAbilityUsageEntry, FAbilityUsageArray>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FAbilityUsageArray> : public TStructOpsTypeTraitsBase2<FAbilityUsageArray>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+// Resets bump a stamp instead of clearing entries; entries written before the stamp read as zero
+USTRUCT()
+struct DBTPLUGINTEST_API FAbilityCounterResetStamps
+{
+    GENERATED_BODY()
+
+    static constexpr int32 NumCategories = (int32)EAbilityCategory::SupportingAction + 1;
+
+    UPROPERTY()
+    uint32 Clock = 0;
+
+    UPROPERTY()
+    uint32 GlobalResetStamp = 0;
+
+    UPROPERTY()
+    uint32 CategoryResetStamps[NumCategories] = {};
+};
+
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class DBTPLUGINTEST_API UAbilityCounterComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UAbilityCounterComponent();
+
+    UPROPERTY(BlueprintAssignable, Category = "Ability Counter")
+    FOnAbilityUsedSignature OnAbilityUsed;
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    int32 GetAbilityUsageCount(TSubclassOf<class UGameplayAbility> AbilityClass) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    int32 GetAbilityUsageCountByName(const FString& AbilityClassName) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    TMap<FString, int32> GetAllAbilityUsageStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    int32 GetLifetimeAbilityUsageCountByName(const FString& AbilityClassName) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    TMap<FString, int32> GetAllLifetimeAbilityUsageStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    void ResetAllCounters();
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    void ResetAbilityCounter(const FString& AbilityName);
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    void ResetCategoryCounters(EAbilityCategory Category);
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    void PrintStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    void DisplayStatsOnScreen(float Duration = 5.0f) const;
+
+    UFUNCTION(Exec)
+    void ShowAbilityStats();
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    void IncrementAbilityCounter(const FString& AbilityName);
+
+    UFUNCTION(BlueprintCallable, Category = "Ability Counter")
+    void IncrementAbilityCounterInCategory(const FString& AbilityName, EAbilityCategory Category);
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    virtual void PostInitProperties() override;
+
+protected:
+    virtual void BeginPlay() override;
+
+    // When false, counts replicate only to the owning connection
+    UPROPERTY(EditDefaultsOnly, Category = "Ability Counter")
+    bool bReplicateToAllConnections = false;
+
+private:
+    friend struct FAbilityUsageEntry;
+
+    void IncrementAbilityCounterInternal(const FString& AbilityName, uint8 Category);
+
+    int32 GetEffectiveUsageCount(const FAbilityUsageEntry& Entry) const;
+
+    void SyncReplicatedEntry(const FAbilityUsageEntry& Entry);
+
+    void ApplyReplicatedEntry(const FAbilityUsageEntry& Entry);
+
+    void RemoveReplicatedEntry(const FAbilityUsageEntry& Entry);
+
+    UPROPERTY()
+    TMap<FString, FAbilityUsageEntry> AbilityUsageMap;
+
+    UPROPERTY(Replicated)
+    FAbilityUsageArray ReplicatedUsage;
+
+    UPROPERTY(Replicated)
+    FAbilityCounterResetStamps ResetStamps;
+
+    // Server-side lookup from ability name to its index in ReplicatedUsage.Items
+    TMap<FString, int32> ReplicatedUsageIndices;
 };
\ No newline at end of file
@@ -1,72 +1,97 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Abilities/GameplayAbility.h"
-#include "AbilityCategoryUtils.h"
-#include "DBTAbilityBase.generated.h"
-
-class UBTCompositeNode;
-class UBTTaskNode;
-class UBehaviorTreeComponent;
-//class AAIController;
-//class AActor;
-
-struct FTaskNodeInfo
-{
-    UBTTaskNode* TaskNode;
-    UBTCompositeNode* ParentComposite;
-    int32 ChildIndex;
-
-    FTaskNodeInfo(UBTTaskNode* InTaskNode = nullptr, UBTCompositeNode* InParentComposite = nullptr, int32 InChildIndex = -1)
-        : TaskNode(InTaskNode)
-        , ParentComposite(InParentComposite)
-        , ChildIndex(InChildIndex)
-    {
-    }
-};
-
-UCLASS(Abstract, Blueprintable)
-class DBTPLUGINTEST_API UDBTAbilityBase : public UGameplayAbility
-{
-    GENERATED_BODY()
-
-public:
-    UDBTAbilityBase();
-
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dynamic Behavior")
-    EAbilityCategory ActionCategory = EAbilityCategory::OffensiveAction;
-
-    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior")
-    FString GetActionCategoryString() const;
-
-protected:
-    virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle,
-                                 const FGameplayAbilityActorInfo* ActorInfo,
-                                 const FGameplayAbilityActivationInfo ActivationInfo,
-                                 const FGameplayEventData* TriggerEventData) override;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Ability Counter")
-    int32 UsageCount = 0;
-
-    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior")
-    void IncrementUsageCount();
-
-private:
-    void CheckAllBehaviorTreesOnAbilityUse();
-    
-    void CheckCompositeNodeRecursive(UBTCompositeNode* Node);
-
-    bool CheckSingleCompositeNode(UBTCompositeNode* Node);
-
-    void CollectCompositeNodeLimitChanges(UBTCompositeNode* Node, TArray<int32>& LimitChanges);
-
-    void CheckForUsageCountReset(const TArray<int32>& LimitChanges);
-
-    void GetAllTaskNodesFromComposite(UBTCompositeNode* Composite, TArray<class UBTTaskNode*>& OutTaskNodes);
-
-    void GetAllTaskNodesWithInfo(UBTCompositeNode* Composite, TArray<struct FTaskNodeInfo>& OutTaskNodes);
-    
-    void SwapTaskNodePriorities(TArray<struct FTaskNodeInfo>& FirstArray, TArray<struct FTaskNodeInfo>& SecondArray);
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbility.h"
+#include "AbilityCategoryUtils.h"
+#include "DBTAbilityBase.generated.h"
+
+class UBTCompositeNode;
+class UBTTaskNode;
+class UBehaviorTreeComponent;
+//class AAIController;
+//class AActor;
+
+struct FTaskNodeInfo
+{
+    UBTTaskNode* TaskNode;
+    UBTCompositeNode* ParentComposite;
+    int32 ChildIndex;
+
+    FTaskNodeInfo(UBTTaskNode* InTaskNode = nullptr, UBTCompositeNode* InParentComposite = nullptr, int32 InChildIndex = -1)
+        : TaskNode(InTaskNode)
+        , ParentComposite(InParentComposite)
+        , ChildIndex(InChildIndex)
+    {
+    }
+};
+
+struct FDBTAbilityUseContext
+{
+    FGameplayAbilitySpecHandle Handle;
+    const FGameplayAbilityActorInfo* ActorInfo;
+    int32 UsageCount;
+
+    // Component running the tree being checked; set per AI controller
+    const UBehaviorTreeComponent* BTComponent = nullptr;
+
+    FDBTAbilityUseContext(FGameplayAbilitySpecHandle InHandle, const FGameplayAbilityActorInfo* InActorInfo, int32 InUsageCount)
+        : Handle(InHandle)
+        , ActorInfo(InActorInfo)
+        , UsageCount(InUsageCount)
+    {
+    }
+
+    AActor* GetAvatarActor() const
+    {
+        return ActorInfo && ActorInfo->AvatarActor.IsValid() ? ActorInfo->AvatarActor.Get() : nullptr;
+    }
+};
+
+UCLASS(Abstract, Blueprintable)
+class DBTPLUGINTEST_API UDBTAbilityBase : public UGameplayAbility
+{
+    GENERATED_BODY()
+
+public:
+    UDBTAbilityBase();
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Dynamic Behavior")
+    EAbilityCategory ActionCategory = EAbilityCategory::OffensiveAction;
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior")
+    FString GetActionCategoryString() const;
+
+protected:
+    virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle,
+                                 const FGameplayAbilityActorInfo* ActorInfo,
+                                 const FGameplayAbilityActivationInfo ActivationInfo,
+                                 const FGameplayEventData* TriggerEventData) override;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ability Counter")
+    int32 GetUsageCount() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior")
+    void IncrementUsageCount();
+
+    // Usage is kept per ASC and spec handle, so this also works for NonInstanced abilities
+    void IncrementUsageCountForSpec(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo) const;
+
+private:
+    void CheckAllBehaviorTreesOnAbilityUse(const FDBTAbilityUseContext& Context) const;
+    
+    void CheckCompositeNodeRecursive(UBTCompositeNode* Node, const FDBTAbilityUseContext& Context) const;
+
+    bool CheckSingleCompositeNode(UBTCompositeNode* Node, const FDBTAbilityUseContext& Context) const;
+
+    void CollectCompositeNodeLimitChanges(UBTCompositeNode* Node, TArray<int32>& LimitChanges) const;
+
+    void CheckForUsageCountReset(const TArray<int32>& LimitChanges, const FDBTAbilityUseContext& Context) const;
+
+    void GetAllTaskNodesFromComposite(UBTCompositeNode* Composite, TArray<class UBTTaskNode*>& OutTaskNodes) const;
+
+    void GetAllTaskNodesWithInfo(UBTCompositeNode* Composite, TArray<struct FTaskNodeInfo>& OutTaskNodes) const;
+    
+    void SwapTaskNodePriorities(TArray<struct FTaskNodeInfo>& FirstArray, TArray<struct FTaskNodeInfo>& SecondArray, const FDBTAbilityUseContext& Context) const;
 };
\ No newline at end of file
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayAbilitySpec.h"
+#include "UObject/ObjectKey.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * Per-ASC usage counts of DBT abilities, keyed by ability spec handle.
+ * Keeping the counts here instead of on the ability object lets DBT abilities run NonInstanced.
+ * Entries of destroyed ability system components are dropped after garbage collection.
+ */
+class DBTPLUGINTEST_API FDBTAbilityUsageTable
+{
+public:
+    static FDBTAbilityUsageTable& Get();
+
+    static void Release();
+
+    int32 IncrementUsageCount(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle);
+
+    int32 GetUsageCount(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle) const;
+
+    void ResetUsageCount(const UAbilitySystemComponent* AbilitySystem, FGameplayAbilitySpecHandle Handle);
+
+    void RemoveAbilitySystem(const UAbilitySystemComponent* AbilitySystem);
+
+    ~FDBTAbilityUsageTable();
+
+private:
+    struct FSpecUsage
+    {
+        FGameplayAbilitySpecHandle Handle;
+        int32 UsageCount = 0;
+    };
+
+    struct FAbilitySystemUsage
+    {
+        TWeakObjectPtr<const UAbilitySystemComponent> AbilitySystem;
+
+        // Few DBT abilities per ASC, so a linear scan over inline storage beats a hash map
+        TArray<FSpecUsage, TInlineAllocator<4>> Specs;
+    };
+
+    FDBTAbilityUsageTable();
+
+    void PruneDestroyedAbilitySystems();
+
+    TMap<FObjectKey, FAbilitySystemUsage> UsageByAbilitySystem;
+
+    FDelegateHandle PostGarbageCollectHandle;
+
+    static FDBTAbilityUsageTable* Instance;
+};
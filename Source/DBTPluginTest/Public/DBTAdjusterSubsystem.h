@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "DBTMaxValuesConfig.h"
+#include "DBTAdjusterSubsystem.generated.h"
+
+class ACharacter;
+class UMaxPropertiesAdjusterComponent;
+
+/**
+ * Runs every UMaxPropertiesAdjusterComponent of a world periodically.
+ * Each adjuster gets its own phase inside the period so passes do not line up. A due pass only
+ * records its characters; they are then read, computed and written in slices until the
+ * dbt.Adjuster.FrameBudgetUs budget of the frame is spent, so no value is written stale.
+ * Characters are scheduled on their own: whichever adjuster reaches a character first adjusts it,
+ * and no other pass takes it until its period has elapsed and that adjustment is written.
+ */
+UCLASS()
+class DBTPLUGINTEST_API UDBTAdjusterSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+    virtual void Deinitialize() override;
+
+    /** Returns the delay until the first pass of the adjuster. */
+    float RegisterAdjuster(UMaxPropertiesAdjusterComponent* Adjuster);
+
+    void UnregisterAdjuster(UMaxPropertiesAdjusterComponent* Adjuster);
+
+    int32 GetPendingCharacterCount() const { return PendingCharacterCount; }
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    struct FScheduledAdjuster
+    {
+        TWeakObjectPtr<UMaxPropertiesAdjusterComponent> Adjuster;
+        double NextRunTime = 0.0;
+    };
+
+    struct FPendingPass
+    {
+        TWeakObjectPtr<UMaxPropertiesAdjusterComponent> Adjuster;
+        FDBTMaxValuesConfig::FTablePtr Config;
+
+        TArray<TWeakObjectPtr<ACharacter>> Characters;
+        int32 NextCharacter = 0;
+
+        int32 GetRemaining() const { return Characters.Num() - NextCharacter; }
+    };
+
+    struct FScheduledCharacter
+    {
+        double NextRunTime = 0.0;
+
+        // Queued in a pass and not written yet
+        bool bPending = false;
+    };
+
+    static float GetPeriod();
+
+    bool HasPendingPass(const UMaxPropertiesAdjusterComponent* Adjuster) const;
+
+    void QueueDuePasses(double Now);
+
+    void ProcessPendingPasses();
+
+    /** Frees the characters a pass has not written yet so other passes can take them. */
+    void ReleasePass(const FPendingPass& Pass);
+
+    TArray<FScheduledAdjuster> Adjusters;
+
+    // Oldest first; finished passes and passes of destroyed adjusters are removed every tick
+    TArray<FPendingPass> PendingPasses;
+    int32 PendingCharacterCount = 0;
+
+    TMap<TWeakObjectPtr<ACharacter>, FScheduledCharacter> ScheduledCharacters;
+
+    int32 RegisteredCount = 0;
+};
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "DBTMaxPropertyLayout.h"
+#include "DBTMaxValuesConfig.h"
+
+class ACharacter;
+class UAbilitySystemComponent;
+struct FDBTMaxAttributeLayout;
+
+struct FDBTMaxPropertyChange
+{
+    FName PropertyName;
+    double OldValue = 0.0;
+    double NewValue = 0.0;
+};
+
+/** What an adjustment would do to one character. Changes are in layout order. */
+struct FDBTCharacterAdjustmentDiff
+{
+    TWeakObjectPtr<ACharacter> Character;
+    FName CharacterName;
+
+    // Exactly one of the layouts is set, depending on whether the character is adjusted through GAS
+    TSharedPtr<const FDBTMaxPropertyLayout, ESPMode::ThreadSafe> PropertyLayout;
+    TSharedPtr<const FDBTMaxAttributeLayout, ESPMode::ThreadSafe> AttributeLayout;
+    TWeakObjectPtr<UAbilitySystemComponent> AbilitySystem;
+
+    double Coefficient = 1.0;
+    TArray<FDBTMaxPropertyChange> Changes;
+};
+
+struct DBTPLUGINTEST_API FDBTAdjustmentDiff
+{
+    TArray<FDBTCharacterAdjustmentDiff> Characters;
+
+    void DumpToLog() const;
+};
+
+typedef TSharedPtr<const FDBTAdjustmentDiff, ESPMode::ThreadSafe> FDBTAdjustmentDiffPtr;
+
+/**
+ * Dry-run form of the max properties adjustment.
+ * Current values are snapshotted on the game thread, the new values are computed on a worker
+ * and returned as a diff. Committing the diff only writes the precomputed values; characters
+ * whose values changed since the snapshot are skipped.
+ */
+class DBTPLUGINTEST_API FDBTAdjustmentPreview
+{
+public:
+    static TFuture<FDBTAdjustmentDiffPtr> ComputeAsync(const TArray<ACharacter*>& Characters, FDBTMaxValuesConfig::FTablePtr Config);
+
+    /** Applies the diff on the game thread and returns the number of adjusted characters. */
+    static int32 Commit(const FDBTAdjustmentDiff& Diff);
+
+private:
+    static void ComputeCharacter(FDBTCharacterAdjustmentDiff& CharacterDiff, const FDBTMaxValuesTable& Config);
+};
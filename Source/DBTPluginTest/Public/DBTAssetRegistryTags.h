@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+class UBehaviorTree;
+class UBTCompositeNode;
+
+/** Dynamic behavior metadata of one Behavior Tree, as stored in its asset registry tags. */
+struct DBTPLUGINTEST_API FDBTBehaviorTreeSummary
+{
+    int32 DynamicNodeCount = 0;
+
+    // Sorted, without duplicates
+    TArray<FString> Categories;
+
+    int32 MaxLimitChange = 0;
+
+    bool HasDynamicData() const { return DynamicNodeCount > 0 || MaxLimitChange > 0; }
+
+    static FDBTBehaviorTreeSummary FromBehaviorTree(const UBehaviorTree* BehaviorTree);
+
+    /** Reads the summary from registry tags. Returns false for assets saved without them. */
+    static bool FromAssetData(const FAssetData& AssetData, FDBTBehaviorTreeSummary& OutSummary);
+};
+
+/** One "Name=Value" entry of a per-node or per-controller registry tag. */
+struct FDBTTaggedEntry
+{
+    FString Name;
+    FString Value;
+};
+
+/**
+ * Writes FDBTBehaviorTreeSummary and the per-node data into the asset registry tags of Behavior
+ * Trees when they are saved, and the AI controller data into the tags of AI controller
+ * Blueprints and maps, so tools can list dynamic data without loading packages. In the editor
+ * the tags are also read back into UDBTBehaviorTreeDataManager when those assets load, and
+ * saving a Behavior Tree rewrites its FDBTBehaviorTreeIndex file for runtime builds.
+ */
+class DBTPLUGINTEST_API FDBTAssetRegistryTags
+{
+public:
+    static const FName DynamicNodeCountTag;
+    static const FName CategoriesTag;
+    static const FName MaxLimitChangeTag;
+
+    // "NodeName=Category" per dynamic task node
+    static const FName DynamicTasksTag;
+
+    // "NodeName=LimitChange" per composite node
+    static const FName LimitChangesTag;
+
+    // "ObjectName=DynamicFlag:TimeLimit" per AI controller default object or placed actor
+    static const FName DynamicControllersTag;
+
+#if WITH_EDITOR
+    static void Register();
+
+    static void Unregister();
+#endif
+
+    /** Queries the asset registry only; no package is loaded. */
+    static void FindBehaviorTrees(TArray<TPair<FAssetData, FDBTBehaviorTreeSummary>>& OutTrees, bool bOnlyWithDynamicData = true);
+
+    /** AI controller Blueprints and maps saved with DynamicControllersTag. */
+    static void FindControllerAssets(TArray<FAssetData>& OutAssets);
+
+    static void ReadEntries(const FAssetData& AssetData, FName Tag, TArray<FDBTTaggedEntry>& OutEntries);
+
+    static bool ParseControllerEntry(const FDBTTaggedEntry& Entry, bool& bOutDynamic, int32& OutTimeLimit);
+
+private:
+    friend struct FDBTBehaviorTreeSummary;
+
+#if WITH_EDITOR
+    static void GetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& InOutTags);
+
+    static void OnAssetLoaded(UObject* Object);
+
+    static void OnFilesLoaded();
+
+    /** Returns false if the asset has a saved package whose tags could not be read yet. */
+    static bool RestoreFromTags(UObject* Object);
+
+    static bool ConsumePendingRestore(const UObject* Object, UObject*& OutObject);
+#endif
+
+    static void AccumulateComposite(const UBTCompositeNode* Composite, FDBTBehaviorTreeSummary& Summary, TSet<FString>& Categories);
+
+#if WITH_EDITOR
+    static FDelegateHandle ExtraObjectTagsHandle;
+    static FDelegateHandle AssetLoadedHandle;
+    static FDelegateHandle PackageSavedHandle;
+    static FDelegateHandle FilesLoadedHandle;
+
+    // Loaded assets whose saved data is not restored yet; their tags must not be rewritten from the data manager
+    static TArray<TWeakObjectPtr<UObject>> PendingRestores;
+#endif
+};
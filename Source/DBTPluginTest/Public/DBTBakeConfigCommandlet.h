@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DBTBakeConfigCommandlet.generated.h"
+
+/**
+ * Bakes the adjuster JSON config into its binary form before packaging.
+ * Usage: -run=DBTBakeConfig [-Json=<path>] [-Out=<path>]
+ */
+UCLASS()
+class DBTPLUGINTEST_API UDBTBakeConfigCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UDBTBakeConfigCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -1,81 +1,115 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UObject/NoExportTypes.h"
-#include "DBTBehaviorTreeDataManager.generated.h"
-
-UCLASS(BlueprintType)
-class DBTPLUGINTEST_API UDBTBehaviorTreeDataManager : public UObject
-{
-    GENERATED_BODY()
-
-public:
-    static UDBTBehaviorTreeDataManager& Get();
-    
-    static void Release();
-
-    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
-    void SetLimitChangeForNode(UObject* Node, int32 LimitChange);
-    
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
-    int32 GetLimitChangeForNode(UObject* Node) const;
-    
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
-    bool HasLimitChangeForNode(UObject* Node) const;
-    
-    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
-    void SetTaskNodeDynamicData(UObject* TaskNode, bool bIsDynamic, const FString& Category);
-    
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
-    bool GetTaskNodeIsDynamic(UObject* TaskNode) const;
-    
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
-    FString GetTaskNodeCategory(UObject* TaskNode) const;
-
-    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
-	void SetAIControllerDynamicBehaviorFlag(UObject* AIController, bool bFlag);
-
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
-	bool GetAIControllerDynamicBehaviorFlag(UObject* AIController) const;
-
-	UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
-	void SetAIControllerTimeLimit(UObject* AIController, int32 TimeLimit);
-
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
-	int32 GetAIControllerTimeLimit(UObject* AIController) const;
-
-    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
-    void SetGlobalAdjustmentDelay(float DelaySeconds);
-    
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
-    float GetGlobalAdjustmentDelay() const;
-
-    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
-    bool IsAnyAIControllerDynamicBehaviorEnabled() const;
-
-    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
-    void ClearAllData();
-
-protected:
-    UPROPERTY()
-    TMap<TWeakObjectPtr<UObject>, int32> NodeDataMap;
-    
-    UPROPERTY()
-    TMap<TWeakObjectPtr<UObject>, bool> TaskNodeDynamicFlagsMap;
-    
-    UPROPERTY()
-    TMap<TWeakObjectPtr<UObject>, FString> TaskNodeCategoriesMap;
-
-    UPROPERTY()
-    TMap<TWeakObjectPtr<UObject>, bool> AIControllerDynamicBehaviorFlags;
-    
-    UPROPERTY()
-    TMap<TWeakObjectPtr<UObject>, int32> AIControllerTimeLimits;
-
-    UPROPERTY()
-    float GlobalAdjustmentDelay = 5.0f;
-
-    static UDBTBehaviorTreeDataManager* Instance;
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "DBTBehaviorTreeDataManager.generated.h"
+
+UCLASS(BlueprintType)
+class DBTPLUGINTEST_API UDBTBehaviorTreeDataManager : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    static UDBTBehaviorTreeDataManager& Get();
+    
+    static void Release();
+
+    /** Returns null instead of creating the instance, for callers that run during shutdown. */
+    static UDBTBehaviorTreeDataManager* GetIfExists() { return Instance; }
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void SetLimitChangeForNode(UObject* Node, int32 LimitChange);
+    
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
+    int32 GetLimitChangeForNode(UObject* Node) const;
+    
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
+    bool HasLimitChangeForNode(UObject* Node) const;
+    
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void SetTaskNodeDynamicData(UObject* TaskNode, bool bIsDynamic, const FString& Category);
+    
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
+    bool GetTaskNodeIsDynamic(UObject* TaskNode) const;
+    
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
+    FString GetTaskNodeCategory(UObject* TaskNode) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+	void SetAIControllerDynamicBehaviorFlag(UObject* AIController, bool bFlag);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
+	bool GetAIControllerDynamicBehaviorFlag(UObject* AIController) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+	void SetAIControllerTimeLimit(UObject* AIController, int32 TimeLimit);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
+	int32 GetAIControllerTimeLimit(UObject* AIController) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void SetGlobalAdjustmentDelay(float DelaySeconds);
+    
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
+    float GetGlobalAdjustmentDelay() const;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dynamic Behavior Tree")
+    bool IsAnyAIControllerDynamicBehaviorEnabled() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void ClearAllData();
+
+    // Bulk setters record one undo entry and log one line for the whole selection
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void SetLimitChangeForNodes(const TArray<UObject*>& Nodes, int32 LimitChange);
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void SetTaskNodesDynamicFlag(const TArray<UObject*>& TaskNodes, bool bIsDynamic, const FString& DefaultCategory);
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void SetTaskNodesCategory(const TArray<UObject*>& TaskNodes, const FString& Category);
+
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void SetAIControllersTimeLimit(const TArray<UObject*>& AIControllers, int32 TimeLimit);
+
+    /** Drops the limit change, dynamic flag and category of each node. */
+    UFUNCTION(BlueprintCallable, Category = "Dynamic Behavior Tree")
+    void RemoveNodes(const TArray<UObject*>& Nodes);
+
+#if WITH_EDITOR
+    virtual void PostEditUndo() override;
+
+    /** Broadcast after undo/redo restored the maps, so open detail panels can resync. */
+    FSimpleMulticastDelegate OnDataRestoredByUndo;
+#endif
+
+    const TMap<TWeakObjectPtr<UObject>, int32>& GetAllLimitChanges() const { return NodeDataMap; }
+
+    const TMap<TWeakObjectPtr<UObject>, bool>& GetAllTaskNodeDynamicFlags() const { return TaskNodeDynamicFlagsMap; }
+
+    const TMap<TWeakObjectPtr<UObject>, bool>& GetAllAIControllerDynamicBehaviorFlags() const { return AIControllerDynamicBehaviorFlags; }
+
+protected:
+    UPROPERTY()
+    TMap<TWeakObjectPtr<UObject>, int32> NodeDataMap;
+    
+    UPROPERTY()
+    TMap<TWeakObjectPtr<UObject>, bool> TaskNodeDynamicFlagsMap;
+    
+    UPROPERTY()
+    TMap<TWeakObjectPtr<UObject>, FString> TaskNodeCategoriesMap;
+
+    UPROPERTY()
+    TMap<TWeakObjectPtr<UObject>, bool> AIControllerDynamicBehaviorFlags;
+    
+    UPROPERTY()
+    TMap<TWeakObjectPtr<UObject>, int32> AIControllerTimeLimits;
+
+    UPROPERTY()
+    float GlobalAdjustmentDelay = 5.0f;
+
+    static UDBTBehaviorTreeDataManager* Instance;
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+#include "AbilityCategoryUtils.h"
+
+class UBehaviorTree;
+
+struct DBTPLUGINTEST_API FDBTBehaviorTreeGeneratorParams
+{
+    // Composite levels counting the root; tasks form one more level below the deepest of them
+    int32 Depth = 3;
+    int32 FanOut = 4;
+
+    // Generation stops adding composites once this many nodes exist, filling the rest with tasks
+    int32 MaxNodes = 100000;
+
+    // Chance that a composite is a sequence rather than a selector
+    float SequenceRatio = 0.5f;
+
+    // Chance that a task is flagged dynamic
+    float DynamicTaskFraction = 0.5f;
+
+    // Relative weights for dynamic task categories, indexed by EAbilityCategory
+    float CategoryWeights[3] = { 1.0f, 1.0f, 1.0f };
+
+    // LimitChange for the root, drawn from [Min, Max]; 0 leaves the root without one
+    int32 RootLimitChangeMin = 3;
+    int32 RootLimitChangeMax = 3;
+
+    // Chance that a non-root composite also gets a LimitChange, to exercise validation
+    float NonRootLimitChangeFraction = 0.0f;
+
+    int32 Seed = 0;
+};
+
+/** Owns a generated tree; releasing it also removes the tree's nodes from the data manager. */
+struct DBTPLUGINTEST_API FDBTGeneratedBehaviorTree
+{
+    TStrongObjectPtr<UBehaviorTree> Tree;
+    int32 NumComposites = 0;
+    int32 NumTasks = 0;
+    int32 NumDynamicTasks = 0;
+
+    FDBTGeneratedBehaviorTree() = default;
+    FDBTGeneratedBehaviorTree(FDBTGeneratedBehaviorTree&& Other);
+    FDBTGeneratedBehaviorTree& operator=(FDBTGeneratedBehaviorTree&& Other);
+    FDBTGeneratedBehaviorTree(const FDBTGeneratedBehaviorTree&) = delete;
+    FDBTGeneratedBehaviorTree& operator=(const FDBTGeneratedBehaviorTree&) = delete;
+
+    ~FDBTGeneratedBehaviorTree() { Reset(); }
+
+    void Reset();
+};
+
+/**
+ * Builds transient Behavior Trees of a given shape for tests and benchmarks and registers their
+ * dynamic metadata with UDBTBehaviorTreeDataManager. The same params and seed always produce
+ * the same tree.
+ */
+class DBTPLUGINTEST_API FDBTBehaviorTreeGenerator
+{
+public:
+    static FDBTGeneratedBehaviorTree Generate(const FDBTBehaviorTreeGeneratorParams& Params);
+
+private:
+    static EAbilityCategory PickCategory(const FDBTBehaviorTreeGeneratorParams& Params, FRandomStream& Random);
+};
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "AssetData.h"
+
+class UBehaviorTree;
+
+/**
+ * Baked copy of the dynamic behavior data of one Behavior Tree, keyed by node name so it can
+ * be restored into UDBTBehaviorTreeDataManager when the tree is used at runtime.
+ * Written into Config/DBTIndex by the editor whenever the tree is saved, and baked from the
+ * registry tags by the DBTValidate commandlet.
+ */
+struct DBTPLUGINTEST_API FDBTBehaviorTreeIndex
+{
+    static constexpr uint32 FileMagic = 0x58494244; // "DBIX"
+    static constexpr uint16 FileVersion = 1;
+
+    struct FTaskEntry
+    {
+        FName NodeName;
+        FString Category;
+    };
+
+    FSoftObjectPath TreePath;
+    TArray<FTaskEntry> DynamicTasks;
+    TArray<TPair<FName, int32>> LimitChanges;
+
+    bool IsEmpty() const { return DynamicTasks.Num() == 0 && LimitChanges.Num() == 0; }
+
+    /** Same entries regardless of order. */
+    bool HasSameEntries(const FDBTBehaviorTreeIndex& Other) const;
+
+    static FDBTBehaviorTreeIndex FromBehaviorTree(const UBehaviorTree* BehaviorTree);
+
+    /** Reads the per-node registry tags written by FDBTAssetRegistryTags. */
+    static FDBTBehaviorTreeIndex FromAssetData(const FAssetData& AssetData);
+
+    static FString GetIndexFilePath(const FSoftObjectPath& TreePath, const FString& IndexDirectory = FString());
+
+    bool SaveToFile(const FString& FilePath) const;
+
+    bool LoadFromFile(const FString& FilePath);
+
+    /** Resolves node names against the loaded tree and registers them with the data manager. */
+    int32 ApplyToBehaviorTree(UBehaviorTree* BehaviorTree, TArray<FName>* OutUnresolvedNodes = nullptr) const;
+
+#if WITH_EDITOR
+    /** Rewrites the index file of a saved Behavior Tree package, or deletes it when the tree has no dynamic data. */
+    static void WriteForSavedPackage(const FString& PackageFileName, UObject* PackageObject);
+#endif
+};
+
+/**
+ * Applies the baked index of each Behavior Tree once, the first time the tree is seen. Does
+ * nothing in the editor, where the data is restored from registry tags when the tree loads and
+ * reapplying it would undo edits made since.
+ */
+class DBTPLUGINTEST_API FDBTBehaviorTreeIndexLoader
+{
+public:
+    static FDBTBehaviorTreeIndexLoader& Get();
+
+    static void Release();
+
+    void EnsureApplied(UBehaviorTree* BehaviorTree);
+
+private:
+    TSet<FObjectKey> VisitedTrees;
+
+    static FDBTBehaviorTreeIndexLoader* Instance;
+};
@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UBTCompositeNode;
+class UBehaviorTreeComponent;
+
+enum class EDBTDebugSampleType : uint8
+{
+    LimitCheck,
+    Swap
+};
+
+struct FDBTDebugSample
+{
+    EDBTDebugSampleType Type = EDBTDebugSampleType::LimitCheck;
+    FObjectKey Composite;
+
+    // Composites are shared by every AI running the tree, so samples keep the component they came from
+    FObjectKey Owner;
+
+    // World time, so pause and time dilation are taken into account
+    double Time = 0.0;
+
+    // LimitChange and usage count for limit checks, swapped child indices for swaps
+    int32 ValueA = 0;
+    int32 ValueB = 0;
+};
+
+/**
+ * Fixed-size ring buffer of limit checks and priority swaps for live debugging.
+ * Recording is one slot write on the game thread; readers fold the samples they have not seen
+ * yet at their own pace, and samples overwritten before being read are simply lost.
+ * Controlled by dbt.Debug.Trace and dbt.Debug.TraceLimitCheckRate.
+ */
+class DBTPLUGINTEST_API FDBTDebugTrace
+{
+public:
+    static constexpr int32 Capacity = 1024;
+
+    static FDBTDebugTrace& Get();
+
+    static void Release();
+
+    static bool IsEnabled();
+
+    void RecordLimitCheck(const UBehaviorTreeComponent* Owner, const UBTCompositeNode* Composite, int32 LimitChange, int32 UsageCount);
+
+    void RecordSwap(const UBehaviorTreeComponent* Owner, const UBTCompositeNode* Composite, int32 FirstIndex, int32 SecondIndex);
+
+    /** Appends samples written after Cursor and returns the cursor to pass next time. */
+    uint64 ReadSince(uint64 Cursor, TArray<FDBTDebugSample>& OutSamples) const;
+
+private:
+    FDBTDebugTrace();
+
+    void Push(EDBTDebugSampleType Type, const UBehaviorTreeComponent* Owner, const UBTCompositeNode* Composite, int32 ValueA, int32 ValueB);
+
+    TArray<FDBTDebugSample> Ring;
+    uint64 Written = 0;
+    uint32 LimitCheckCounter = 0;
+
+    static FDBTDebugTrace* Instance;
+};
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+#include "Styling/SlateTypes.h"
+
+/**
+ * Value shared by every object of a details panel selection, or unset when they differ.
+ * Computed when the panel is built and updated by the panel's own edits, so Slate bindings
+ * read it without touching the selection on every paint.
+ */
+template<typename ValueType>
+struct TDBTAggregateValue
+{
+    TOptional<ValueType> Value;
+
+    template<typename GetterType>
+    void Recompute(const TArray<TWeakObjectPtr<UObject>>& Objects, GetterType&& Getter)
+    {
+        Value.Reset();
+
+        bool bFirst = true;
+        for (const TWeakObjectPtr<UObject>& ObjPtr : Objects)
+        {
+            if (UObject* Obj = ObjPtr.Get())
+            {
+                const ValueType ObjectValue = Getter(Obj);
+                if (bFirst)
+                {
+                    Value = ObjectValue;
+                    bFirst = false;
+                }
+                else if (Value.GetValue() != ObjectValue)
+                {
+                    Value.Reset();
+                    return;
+                }
+            }
+        }
+    }
+
+    /** Edits apply the same value to the whole selection, which makes it uniform. */
+    void Set(const ValueType& NewValue) { Value = NewValue; }
+
+    ValueType Get(const ValueType& MixedValue) const { return Value.Get(MixedValue); }
+};
+
+/** Live objects of the selection whose value differs from NewValue, so a commit can skip no-op edits. */
+template<typename ValueType, typename GetterType>
+TArray<UObject*> GetObjectsToChange(const TArray<TWeakObjectPtr<UObject>>& Objects, const ValueType& NewValue, GetterType&& Getter)
+{
+    TArray<UObject*> Changed;
+    for (const TWeakObjectPtr<UObject>& ObjPtr : Objects)
+    {
+        UObject* Obj = ObjPtr.Get();
+        if (Obj && !(Getter(Obj) == NewValue))
+        {
+            Changed.Add(Obj);
+        }
+    }
+    return Changed;
+}
+
+inline ECheckBoxState ToCheckBoxState(const TDBTAggregateValue<bool>& Aggregate)
+{
+    if (!Aggregate.Value.IsSet())
+    {
+        return ECheckBoxState::Undetermined;
+    }
+    return Aggregate.Value.GetValue() ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+#endif
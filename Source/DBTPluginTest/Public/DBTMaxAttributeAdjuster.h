@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "UObject/StrongObjectPtr.h"
+
+class AActor;
+class UAbilitySystemComponent;
+class UGameplayEffect;
+struct FDBTMaxValuesTable;
+
+/** Max gameplay attributes of one combination of attribute set classes, with the effect that scales them. */
+struct DBTPLUGINTEST_API FDBTMaxAttributeLayout
+{
+    TArray<FGameplayAttribute> Attributes;
+
+    // Instant effect multiplying every attribute by the SetByCaller CoefficientName magnitude
+    TStrongObjectPtr<UGameplayEffect> Effect;
+};
+
+typedef TSharedRef<const FDBTMaxAttributeLayout, ESPMode::ThreadSafe> FDBTMaxAttributeLayoutRef;
+
+/**
+ * Max value adjustment for actors with an ability system component.
+ * Max attributes are resolved once per set of attribute set classes; the adjustment itself
+ * reads attribute base values through the ASC and applies a single instant effect per actor,
+ * so the change goes through the regular GAS replication path.
+ */
+class DBTPLUGINTEST_API FDBTMaxAttributeAdjuster
+{
+public:
+    static const FName CoefficientName;
+
+    static FDBTMaxAttributeAdjuster& Get();
+
+    static void Release();
+
+    /**
+     * Adjusts the Max attributes of Actor. Returns false when the actor has no ASC or no Max
+     * attributes, in which case the caller should fall back to property adjustment.
+     */
+    bool AdjustActor(AActor* Actor, const FDBTMaxValuesTable& Config);
+
+    /** Returns the ASC of Actor if it has Max attributes, along with their layout. */
+    UAbilitySystemComponent* FindMaxAttributes(AActor* Actor, TSharedPtr<const FDBTMaxAttributeLayout, ESPMode::ThreadSafe>& OutLayout);
+
+    /** Applies the layout's effect with Coefficient on the authority. */
+    static void ApplyCoefficient(UAbilitySystemComponent& AbilitySystem, const FDBTMaxAttributeLayout& Layout, double Coefficient);
+
+    FDBTMaxAttributeLayoutRef GetLayout(const UAbilitySystemComponent& AbilitySystem);
+
+    void Invalidate();
+
+    ~FDBTMaxAttributeAdjuster();
+
+private:
+    FDBTMaxAttributeAdjuster();
+
+    static FDBTMaxAttributeLayoutRef BuildLayout(const TArray<UClass*>& AttributeSetClasses);
+
+    void PruneCollectedClasses();
+
+    struct FCachedLayout
+    {
+        TArray<TWeakObjectPtr<UClass>, TInlineAllocator<2>> Classes;
+        FDBTMaxAttributeLayoutRef Layout;
+    };
+
+    // Keyed by the hash of the attribute set classes; Classes resolves collisions
+    TMultiMap<uint32, FCachedLayout> Layouts;
+
+    FDelegateHandle PostGarbageCollectHandle;
+
+    static FDBTMaxAttributeAdjuster* Instance;
+};
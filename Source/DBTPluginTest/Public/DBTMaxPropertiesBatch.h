@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DBTMaxPropertyLayout.h"
+
+class ACharacter;
+struct FDBTMaxValuesTable;
+
+/**
+ * Characters sharing one Max property layout, with their values in structure-of-arrays form.
+ * Values holds one contiguous column per property: Values[PropertyIndex * NumCharacters + CharacterIndex].
+ */
+struct DBTPLUGINTEST_API FDBTAdjustmentBatch
+{
+    FDBTMaxPropertyLayoutRef Layout;
+
+    TArray<ACharacter*> Characters;
+
+    TArray<double> Values;
+
+    // Config value per property
+    TArray<double> FileValues;
+
+    TArray<double> Coefficients;
+
+    // Number of properties with a non-zero config value, shared by all characters of the batch
+    int32 ValidPropertiesCount = 0;
+
+    explicit FDBTAdjustmentBatch(FDBTMaxPropertyLayoutRef InLayout)
+        : Layout(InLayout)
+    {
+    }
+
+    double* GetColumn(int32 PropertyIndex) { return Values.GetData() + PropertyIndex * Characters.Num(); }
+    const double* GetColumn(int32 PropertyIndex) const { return Values.GetData() + PropertyIndex * Characters.Num(); }
+};
+
+/**
+ * Batch form of the max properties adjustment: gather into SoA, compute with SIMD kernels, scatter back.
+ * Gather and compute only read actor memory and run in parallel across batches; the scatter that
+ * writes the new values runs on the game thread.
+ */
+class DBTPLUGINTEST_API FDBTMaxPropertiesBatch
+{
+public:
+    /** Groups characters by layout, splitting groups larger than MaxBatchSize so they can be computed in parallel. */
+    static void BuildBatches(const TArray<ACharacter*>& Characters, TArray<FDBTAdjustmentBatch>& OutBatches, int32 MaxBatchSize = 64);
+
+    static void Gather(FDBTAdjustmentBatch& Batch, const FDBTMaxValuesTable& Config);
+
+    static void ComputeCoefficients(FDBTAdjustmentBatch& Batch);
+
+    /** Multiplies every column by the per-character coefficients in place. */
+    static void ApplyCoefficients(FDBTAdjustmentBatch& Batch);
+
+    /** Gathers and computes every batch in parallel; the adjusted values stay in the batches until scattered. */
+    static void ComputeBatches(TArray<FDBTAdjustmentBatch>& Batches, const FDBTMaxValuesTable& Config);
+
+    static void Scatter(const FDBTAdjustmentBatch& Batch);
+
+    /** Runs all phases on the game thread and returns the number of adjusted characters. */
+    static int32 AdjustCharacters(const TArray<ACharacter*>& Characters, const FDBTMaxValuesTable& Config);
+};
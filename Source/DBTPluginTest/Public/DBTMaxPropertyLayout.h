@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+enum class EDBTNumericKind : uint8
+{
+    Float,
+    Double,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64
+};
+
+struct FDBTMaxPropertyEntry
+{
+    FName Name;
+    FName DeclaringClassName;
+    int32 Offset = 0;
+    EDBTNumericKind Kind = EDBTNumericKind::Float;
+};
+
+/** Numeric "Max" properties of a character class, resolved to raw offsets. */
+struct DBTPLUGINTEST_API FDBTMaxPropertyLayout
+{
+    TArray<FDBTMaxPropertyEntry> Properties;
+
+    static double ReadValue(const void* Container, const FDBTMaxPropertyEntry& Entry);
+
+    static void WriteValue(void* Container, const FDBTMaxPropertyEntry& Entry, double Value);
+};
+
+typedef TSharedRef<const FDBTMaxPropertyLayout, ESPMode::ThreadSafe> FDBTMaxPropertyLayoutRef;
+
+/**
+ * Per-UClass cache of FDBTMaxPropertyLayout.
+ * The class hierarchy is reflected once on first use; entries are dropped when their class is
+ * garbage collected and the whole cache is cleared when classes are reinstanced by a reload.
+ */
+class DBTPLUGINTEST_API FDBTMaxPropertyLayoutCache
+{
+public:
+    static FDBTMaxPropertyLayoutCache& Get();
+
+    static void Release();
+
+    FDBTMaxPropertyLayoutRef GetLayout(UClass* CharacterClass);
+
+    void Invalidate();
+
+    ~FDBTMaxPropertyLayoutCache();
+
+private:
+    FDBTMaxPropertyLayoutCache();
+
+    static FDBTMaxPropertyLayoutRef BuildLayout(UClass* CharacterClass);
+
+    void PruneCollectedClasses();
+
+    struct FCachedLayout
+    {
+        TWeakObjectPtr<UClass> Class;
+        FDBTMaxPropertyLayoutRef Layout;
+    };
+
+    TMap<FObjectKey, FCachedLayout> Layouts;
+
+    FDelegateHandle PostGarbageCollectHandle;
+    FDelegateHandle ObjectsReplacedHandle;
+
+    static FDBTMaxPropertyLayoutCache* Instance;
+};
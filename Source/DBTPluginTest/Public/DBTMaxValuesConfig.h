@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+/** Parsed contents of Config/AIControllerMaxValues.json or its baked binary form. Immutable once published. */
+struct DBTPLUGINTEST_API FDBTMaxValuesTable
+{
+    TMap<FName, double> Values;
+
+    FDateTime SourceTimestamp;
+
+    double GetValue(FName PropertyName) const
+    {
+        const double* Value = Values.Find(PropertyName);
+        return Value ? *Value : 0.0;
+    }
+};
+
+/**
+ * Shared, hot-reloadable cache of the adjuster config.
+ * The file is parsed once and the resulting table is shared by every adjuster. A core ticker
+ * checks the file timestamp on a worker thread and swaps in a freshly parsed table when it
+ * changes, so readers never touch the disk after the first load.
+ * A binary form baked with -run=DBTBakeConfig (or dbt.Adjuster.BakeConfig) is preferred over the
+ * JSON whenever it is at least as new, so packaged servers load the table without parsing text.
+ */
+class DBTPLUGINTEST_API FDBTMaxValuesConfig
+{
+public:
+    typedef TSharedPtr<const FDBTMaxValuesTable, ESPMode::ThreadSafe> FTablePtr;
+
+    static FDBTMaxValuesConfig& Get();
+
+    static void Release();
+
+    static constexpr uint32 BinaryMagic = 0x43544244; // "DBTC"
+    static constexpr uint16 BinaryVersion = 1;
+
+    static FString GetConfigFilePath();
+
+    static FString GetBinaryConfigFilePath();
+
+    /** Converts the JSON config into the binary form read by LoadTable. */
+    static bool BakeBinaryConfig(const FString& JsonFilePath, const FString& BinaryFilePath);
+
+    /** Returns the current table, loading it synchronously only if nothing was loaded yet. */
+    FTablePtr GetTable();
+
+    /** Schedules a background reload regardless of the file timestamp. */
+    void RequestReload();
+
+    ~FDBTMaxValuesConfig();
+
+private:
+    FDBTMaxValuesConfig();
+
+    bool TickReloadCheck(float DeltaTime);
+
+    void StartBackgroundReload(bool bForce);
+
+    void PublishTable(FTablePtr NewTable);
+
+    static FDateTime GetNewestSourceTimestamp();
+
+    static FTablePtr LoadTable();
+
+    static FTablePtr LoadJsonTable(const FString& FilePath);
+
+    static FTablePtr LoadBinaryTable(const FString& FilePath);
+
+    mutable FCriticalSection TableLock;
+    FTablePtr Table;
+
+    std::atomic<bool> bReloadInFlight;
+    FDelegateHandle TickerHandle;
+
+    static FDBTMaxValuesConfig* Instance;
+};
@@ -1,23 +1,60 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Modules/ModuleManager.h"
-
-class FDBTPluginTestModule : public IModuleInterface
-{
-public:
-
-	/** IModuleInterface implementation */
-	virtual void StartupModule() override;
-	virtual void ShutdownModule() override;
-private:
-
-	void RegisterAssetTypeAction(class IAssetTools& AssetTools, TSharedRef<class IAssetTypeActions> Action);
-	void RegisterTaskNodeCustomizations();
-	void RegisterAllTaskClasses(FPropertyEditorModule& PropertyModule);
-	void UnregisterTaskNodeCustomizations();
-
-	TArray<TSharedPtr<class IAssetTypeActions>> CreatedAssetTypeActions;
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "Containers/Ticker.h"
+
+class FDBTPluginTestModule : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	struct FStartupStageTiming
+	{
+		const TCHAR* Name;
+		double Seconds;
+	};
+
+	/** Time each deferred startup stage took when it ran, in run order. Stages still pending are not listed. */
+	const TArray<FStartupStageTiming>& GetStartupStageTimings() const { return StartupStageTimings; }
+
+	bool HasPendingStartupStages() const { return PendingStartupStages.Num() > 0; }
+private:
+
+	struct FStartupStage
+	{
+		const TCHAR* Name;
+		TFunction<void()> Run;
+
+		// Undoes Run, in reverse stage order on module shutdown
+		TFunction<void()> Shutdown;
+	};
+
+	void OnPostEngineInit();
+
+	bool TickStartupStages(float DeltaTime);
+
+	void RunStartupStage(const FStartupStage& Stage);
+
+	void RegisterAssetTypeAction(class IAssetTools& AssetTools, TSharedRef<class IAssetTypeActions> Action);
+	void RegisterTaskNodeCustomizations();
+	void UnregisterTaskNodeCustomizations();
+
+	void PruneCustomizationMaps();
+
+	TArray<TSharedPtr<class IAssetTypeActions>> CreatedAssetTypeActions;
+
+	// Registration deferred to PostEngineInit and run one stage per tick
+	TArray<FStartupStage> PendingStartupStages;
+	TArray<FStartupStage> CompletedStartupStages;
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle StartupTickerHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+	double StartupStagesSeconds = 0.0;
+	TArray<FStartupStageTiming> StartupStageTimings;
+};
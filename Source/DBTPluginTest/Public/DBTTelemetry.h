@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilityCategoryUtils.h"
+#include <atomic>
+
+class FDBTTelemetryWriter;
+
+enum class EDBTTelemetryRecordType : uint8
+{
+    NameDefinition   = 0,
+    AbilityActivated = 1,
+    PrioritySwap     = 2
+};
+
+struct FDBTTelemetryEvent
+{
+    EDBTTelemetryRecordType Type = EDBTTelemetryRecordType::AbilityActivated;
+    uint8 Category = 0;
+    double Timestamp = 0.0;
+
+    // Ability class for activations, behavior tree for swaps
+    FName Primary;
+
+    // Owner actor for activations, composite node for swaps
+    FName Secondary;
+
+    // Usage count for activations, first child index for swaps
+    int32 ValueA = 0;
+
+    // Unused for activations, second child index for swaps
+    int32 ValueB = 0;
+};
+
+/**
+ * Compact binary event stream of ability activations and priority swaps.
+ * Producers push fixed-size events into a lock-free ring buffer and never block; a background
+ * thread drains the buffer into rolling files under Saved/Telemetry/DBT. Events are dropped
+ * (and counted) when the buffer is full. Controlled by the dbt.Telemetry.* console variables.
+ */
+class DBTPLUGINTEST_API FDBTTelemetry
+{
+public:
+    static constexpr uint32 FileMagic = 0x54544244; // "DBTT"
+    static constexpr uint16 FileVersion = 1;
+
+    /** Allocates the ring buffer on first use; record sites check IsEnabled() first. */
+    static FDBTTelemetry& Get();
+
+    static FDBTTelemetry* GetIfExists() { return Instance; }
+
+    static void Release();
+
+    static bool IsEnabled();
+
+    void RecordAbilityActivation(FName AbilityName, FName OwnerName, EAbilityCategory Category, int32 UsageCount);
+
+    void RecordPrioritySwap(FName TreeName, FName CompositeName, int32 FirstIndex, int32 SecondIndex);
+
+    /** Blocks until everything pushed so far has reached the file. */
+    void Flush();
+
+    uint64 GetDroppedEventCount() const { return DroppedEvents.load(std::memory_order_relaxed); }
+
+    ~FDBTTelemetry();
+
+private:
+    friend class FDBTTelemetryWriter;
+
+    static constexpr uint32 RingCapacity = 1 << 16;
+
+    struct FSlot
+    {
+        std::atomic<uint64> Sequence;
+        FDBTTelemetryEvent Event;
+    };
+
+    FDBTTelemetry();
+
+    void Push(const FDBTTelemetryEvent& Event);
+
+    bool Pop(FDBTTelemetryEvent& OutEvent);
+
+    void EnsureWriterStarted();
+
+    TUniquePtr<FSlot[]> Ring;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos;
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> DequeuePos;
+    std::atomic<uint64> DroppedEvents;
+
+    FCriticalSection WriterStartLock;
+    TUniquePtr<FDBTTelemetryWriter> Writer;
+    std::atomic<bool> bWriterStarted;
+
+    static FDBTTelemetry* Instance;
+};
+
+/** Converts telemetry files written by FDBTTelemetry into CSV. */
+class DBTPLUGINTEST_API FDBTTelemetryReader
+{
+public:
+    static bool ConvertToCSV(const FString& InFilePath, const FString& OutFilePath);
+
+    static bool ConvertToCSV(const TArray<uint8>& InData, FString& OutCSV);
+};
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilityCategoryUtils.h"
+#include <atomic>
+
+struct DBTPLUGINTEST_API FDBTUsageSnapshot
+{
+    static constexpr int32 NumCategories = (int32)EAbilityCategory::SupportingAction + 1;
+
+    TMap<FName, int64> UsageByAbility;
+    int64 UsageByCategory[NumCategories] = {};
+    int64 TotalUsage = 0;
+};
+
+/**
+ * Process-wide ability usage totals across all players.
+ * Every thread increments its own shard, so recording never contends with other writers;
+ * shards are merged only when a snapshot is taken.
+ */
+class DBTPLUGINTEST_API FDBTUsageAggregator
+{
+public:
+    static FDBTUsageAggregator& Get();
+
+    static void Release();
+
+    void RecordUsage(FName AbilityClassName, EAbilityCategory Category, int64 Count = 1);
+
+    FDBTUsageSnapshot GetSnapshot() const;
+
+    void Reset();
+
+    void DumpToLog() const;
+
+private:
+    struct FShard
+    {
+        FCriticalSection Lock;
+        TMap<FName, int64> UsageByAbility;
+        int64 UsageByCategory[FDBTUsageSnapshot::NumCategories] = {};
+    };
+
+    FDBTUsageAggregator();
+
+    FShard& GetThreadShard();
+
+    // Unique per instance, so a thread never reuses the shard pointer of a released aggregator
+    const uint64 Generation;
+
+    mutable FCriticalSection ShardsLock;
+    TArray<TUniquePtr<FShard>> Shards;
+
+    static std::atomic<FDBTUsageAggregator*> Instance;
+};
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DBTValidateCommandlet.generated.h"
+
+class UBehaviorTree;
+
+/**
+ * Bakes the runtime index of each Behavior Tree from the tags saved in the tree and validates
+ * the persisted dynamic behavior data, including the AI controller tags of Blueprints and maps.
+ * With -CheckOnly the index files are only compared against the tags, nothing is written.
+ * Returns non-zero when any error was found.
+ * Usage: -run=DBTValidate [-IndexDir=<path>] [-AllTrees] [-CheckOnly]
+ */
+UCLASS()
+class DBTPLUGINTEST_API UDBTValidateCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UDBTValidateCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    struct FIssue
+    {
+        FString Path;
+        FString Message;
+        bool bError = false;
+    };
+
+    static void ValidateBehaviorTree(const UBehaviorTree* BehaviorTree, TArray<FIssue>& OutIssues);
+
+    static void ValidateAIController(const FString& ControllerPath, bool bDynamic, int32 TimeLimit, TArray<FIssue>& OutIssues);
+
+    static void ValidateOrphans(const TSet<const UObject*>& ScannedObjects, TArray<FIssue>& OutIssues);
+};
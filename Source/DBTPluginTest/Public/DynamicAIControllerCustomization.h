@@ -1,18 +1,29 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "IDetailCustomization.h"
-#include "Templates/SharedPointer.h"
-
-class FDynamicAIControllerCustomization : public IDetailCustomization
-{
-public:
-    static TSharedRef<IDetailCustomization> MakeInstance();
-
-    virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
-
-private:
-    TArray<TWeakObjectPtr<UObject>> CustomizedObjects;
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IDetailCustomization.h"
+#include "Templates/SharedPointer.h"
+#include "DBTDetailAggregate.h"
+
+class FDynamicAIControllerCustomization : public IDetailCustomization
+{
+public:
+    static TSharedRef<IDetailCustomization> MakeInstance();
+
+    virtual ~FDynamicAIControllerCustomization();
+
+    virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
+
+private:
+    void CommitTimeLimit(int32 NewValue);
+
+    void ResyncFromDataManager();
+
+    TArray<TWeakObjectPtr<UObject>> CustomizedObjects;
+    FDelegateHandle UndoHandle;
+
+    TDBTAggregateValue<bool> DynamicFlagAggregate;
+    TDBTAggregateValue<int32> TimeLimitAggregate;
 };
\ No newline at end of file
@@ -1,3 +1,3 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
@@ -1,19 +1,25 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-#include "CoreMinimal.h"
-#include "IDetailCustomization.h"
-#include "Templates/SharedPointer.h"
-
-class FBehaviorTreeRootNodeCustomization : public IDetailCustomization
-{
-public:
-    static TSharedRef<IDetailCustomization> MakeInstance();
-
-    virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
-
-    static const TMap<FObjectKey, int32>& GetRootLimitChangeMap() { return RootLimitChangeMap; }
-private:
-    TArray<TWeakObjectPtr<UObject>> CustomizedObjects;
-    static TMap<FObjectKey, int32> RootLimitChangeMap;
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "IDetailCustomization.h"
+#include "Templates/SharedPointer.h"
+#include "DBTDetailAggregate.h"
+
+class FBehaviorTreeRootNodeCustomization : public IDetailCustomization
+{
+public:
+    static TSharedRef<IDetailCustomization> MakeInstance();
+
+    virtual ~FBehaviorTreeRootNodeCustomization();
+
+    virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
+private:
+    void CommitLimitChange(int32 NewValue);
+
+    void ResyncFromDataManager();
+
+    TArray<TWeakObjectPtr<UObject>> CustomizedObjects;
+    FDelegateHandle UndoHandle;
+    TDBTAggregateValue<int32> LimitChangeAggregate;
 };
\ No newline at end of file
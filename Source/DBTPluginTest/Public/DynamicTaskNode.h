@@ -1,34 +1,53 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-
-#if WITH_EDITOR
-#include "IDetailCustomization.h"
-#include "Templates/SharedPointer.h"
-#include "Misc/Guid.h"
-
-class FTaskNodeCustomization : public IDetailCustomization
-{
-public:
-	/** Makes a new instance of this detail layout class for a specific detail view requesting it */
-	static TSharedRef<IDetailCustomization> MakeInstance();
-
-	/** IDetailCustomization interface */
-	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
-	static void ClearFlagsMap() {
-		DynamicBehaviorFlagsMap.Empty();
-		DynamicBehaviorCategoriesMap.Empty();
-	}
-
-	static const TMap<FObjectKey, TSharedPtr<FString>>& GetDynamicBehaviorCategoriesMap() { return DynamicBehaviorCategoriesMap; }
-private:
-	static TMap<FObjectKey, bool> DynamicBehaviorFlagsMap;
-	static TMap<FObjectKey, TSharedPtr<FString>> DynamicBehaviorCategoriesMap;
-
-	TArray<TWeakObjectPtr<UObject>> CustomizedObjects;
-
-	static TArray<TSharedPtr<FString>> CategoryOptions;
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+#include "IDetailCustomization.h"
+#include "Templates/SharedPointer.h"
+#include "Misc/Guid.h"
+#include "DBTDetailAggregate.h"
+#include "AbilityCategoryUtils.h"
+
+class FTaskNodeCustomization : public IDetailCustomization
+{
+public:
+	/** Makes a new instance of this detail layout class for a specific detail view requesting it */
+	static TSharedRef<IDetailCustomization> MakeInstance();
+
+	virtual ~FTaskNodeCustomization();
+
+	/** IDetailCustomization interface */
+	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
+	static void ClearFlagsMap() {
+		DynamicBehaviorFlagsMap.Empty();
+		DynamicBehaviorCategoriesMap.Empty();
+	}
+
+	/** Drops entries whose node was deleted or whose asset was unloaded; called after each GC. */
+	static void PruneStaleEntries();
+
+	static const TMap<FObjectKey, EAbilityCategory>& GetDynamicBehaviorCategoriesMap() { return DynamicBehaviorCategoriesMap; }
+private:
+	static TMap<FObjectKey, bool> DynamicBehaviorFlagsMap;
+	static TMap<FObjectKey, EAbilityCategory> DynamicBehaviorCategoriesMap;
+
+	void CommitDynamicFlag(bool bNewValue);
+
+	void CommitCategory(TSharedPtr<FString> NewValue);
+
+	void ResyncFromDataManager();
+
+	TArray<TWeakObjectPtr<UObject>> CustomizedObjects;
+
+	FDelegateHandle UndoHandle;
+
+	TDBTAggregateValue<bool> DynamicFlagAggregate;
+	TDBTAggregateValue<EAbilityCategory> CategoryAggregate;
+
+	// Combo box items, indexed by EAbilityCategory
+	static TArray<TSharedPtr<FString>> CategoryOptions;
+};
 #endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebuggerCategory.h"
+#include "UObject/ObjectKey.h"
+
+class UBTCompositeNode;
+
+/**
+ * Shows live dynamic behavior data for the debugged AI's current Behavior Tree: limit change
+ * versus the last sampled usage, swap count, time since the last swap and the current child
+ * order of every composite that has dynamic data. Reads FDBTDebugTrace instead of the tree.
+ */
+class FGameplayDebuggerCategory_DynamicBehavior : public FGameplayDebuggerCategory
+{
+public:
+    FGameplayDebuggerCategory_DynamicBehavior();
+
+    static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+    virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+
+private:
+    struct FCompositeStats
+    {
+        int32 LimitChange = 0;
+        int32 LastUsageCount = 0;
+        int32 SwapCount = 0;
+        double LastSwapTime = 0.0;
+    };
+
+    void CollectComposite(UBTCompositeNode* Composite, double Now);
+
+    // Stats of the debugged AI's tree component only, cleared when another AI is debugged
+    TMap<FObjectKey, FCompositeStats> Stats;
+    FObjectKey StatsOwner;
+
+    TArray<struct FDBTDebugSample> PendingSamples;
+    uint64 TraceCursor = 0;
+};
+#endif
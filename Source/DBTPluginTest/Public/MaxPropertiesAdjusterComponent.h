@@ -1,31 +1,83 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Components/ActorComponent.h"
-#include "MaxPropertiesAdjusterComponent.generated.h"
-
-UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
-class DBTPLUGINTEST_API UMaxPropertiesAdjusterComponent : public UActorComponent
-{
-    GENERATED_BODY()
-
-public:
-    UMaxPropertiesAdjusterComponent();
-
-    UFUNCTION(BlueprintCallable, Category = "Max Properties")
-    void StartAdjustmentTimer();
-
-protected:
-    virtual void BeginPlay() override;
-
-    UFUNCTION()
-    void ExecuteAdjustment();
-
-    UFUNCTION()
-    void ExecuteAdjustmentLogic();
-
-private:
-    FTimerHandle AdjustmentTimerHandle;
-};
\ No newline at end of file
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DBTAdjustmentPreview.h"
+#include "MaxPropertiesAdjusterComponent.generated.h"
+
+class ACharacter;
+class AAIController;
+struct FDBTMaxValuesTable;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDBTAdjustmentPreviewReady, const FDBTAdjustmentDiff&);
+
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class DBTPLUGINTEST_API UMaxPropertiesAdjusterComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMaxPropertiesAdjusterComponent();
+
+    /** Registers the component with the world's adjuster scheduler, which runs it periodically. */
+    UFUNCTION(BlueprintCallable, Category = "Max Properties")
+    void StartAdjustmentTimer();
+
+    UFUNCTION(BlueprintCallable, Category = "Max Properties")
+    void StopAdjustmentTimer();
+
+    /** Collects the player characters and dynamic AI characters this component adjusts. Returns false if there is nothing to do. */
+    bool GatherAdjustmentTargets(TArray<ACharacter*>& OutCharacters) const;
+
+    void AdjustCharacters(const TArray<ACharacter*>& Characters, const FDBTMaxValuesTable& Config) const;
+
+    /** Computes what an adjustment would change on a worker thread, without touching any actor. */
+    UFUNCTION(BlueprintCallable, Category = "Max Properties")
+    void PreviewAdjustment();
+
+    /** Writes the values of the last preview. Returns the number of adjusted characters. */
+    UFUNCTION(BlueprintCallable, Category = "Max Properties")
+    int32 CommitPendingAdjustment();
+
+    UFUNCTION(BlueprintCallable, Category = "Max Properties")
+    void DiscardPendingAdjustment();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Max Properties")
+    bool HasPendingAdjustment() const { return PendingAdjustment.IsValid(); }
+
+    FDBTAdjustmentDiffPtr GetPendingAdjustment() const { return PendingAdjustment; }
+
+    FOnDBTAdjustmentPreviewReady OnPreviewReady;
+
+protected:
+    virtual void BeginPlay() override;
+
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Adjusts all characters at once, grouped by class layout, instead of one character at a time
+    UPROPERTY(EditAnywhere, Category = "Max Properties")
+    bool bUseBatchAdjustment = true;
+
+    // Also adjusts characters of AI controllers flagged for dynamic behavior
+    UPROPERTY(EditAnywhere, Category = "Max Properties")
+    bool bAdjustAIControllers = true;
+
+    /** Runs a full adjustment pass immediately, outside of the scheduler. */
+    UFUNCTION()
+    void ExecuteAdjustment();
+
+    UFUNCTION()
+    void ExecuteAdjustmentLogic();
+
+private:
+    static bool IsDynamicBehaviorController(AAIController* AIController);
+
+    void AdjustCharacter(ACharacter* Character, const FDBTMaxValuesTable& Config) const;
+
+    FDBTAdjustmentDiffPtr PendingAdjustment;
+
+    // Bumped by every preview and discard so a late result of an older preview is dropped
+    uint32 PreviewSerial = 0;
+};
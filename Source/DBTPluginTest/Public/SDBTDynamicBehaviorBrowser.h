@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
+
+enum class EDBTBrowserRowKind : uint8
+{
+    BehaviorTree,
+    DynamicTask,
+    CompositeLimit,
+    AIController
+};
+
+struct FDBTBrowserRow
+{
+    EDBTBrowserRowKind Kind = EDBTBrowserRowKind::BehaviorTree;
+    FString Name;
+    FString Category;
+    FString Tree;
+    int32 Value = 0;
+
+    // Asset to open on click; Object is only set for rows that come from loaded objects.
+    // Rows read from the tags of a map keep the actor name in Name, to select it once opened
+    FSoftObjectPath AssetPath;
+    TWeakObjectPtr<UObject> Object;
+};
+
+typedef TSharedPtr<FDBTBrowserRow> FDBTBrowserRowPtr;
+
+/**
+ * Lists dynamic behavior data across the project: Behavior Trees, their dynamic task nodes and
+ * composite limits, and AI controllers in Blueprints and maps. Unloaded assets are read from
+ * their asset registry tags, loaded ones from UDBTBehaviorTreeDataManager. Rows are
+ * virtualized, so only the visible ones get widgets.
+ */
+class SDBTDynamicBehaviorBrowser : public SCompoundWidget
+{
+public:
+    static const FName TabName;
+
+    static void RegisterTabSpawner();
+
+    static void UnregisterTabSpawner();
+
+    SLATE_BEGIN_ARGS(SDBTDynamicBehaviorBrowser) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+private:
+    void RebuildRows();
+
+    void ApplyFilters();
+
+    TSharedRef<ITableRow> OnGenerateRow(FDBTBrowserRowPtr Row, const TSharedRef<STableViewBase>& OwnerTable);
+
+    void OnRowDoubleClicked(FDBTBrowserRowPtr Row);
+
+    TArray<FDBTBrowserRowPtr> AllRows;
+    TArray<FDBTBrowserRowPtr> FilteredRows;
+
+    TSharedPtr<SListView<FDBTBrowserRowPtr>> ListView;
+
+    TArray<TSharedPtr<FString>> CategoryFilterOptions;
+    TSharedPtr<FString> CategoryFilter;
+    FString TreeFilter;
+};
+#endif
@@ -1,14 +1,15 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-using UnrealBuildTool;
-using System.Collections.Generic;
-
-public class DBTPluginProjectTarget : TargetRules
-{
-	public DBTPluginProjectTarget( TargetInfo Target) : base(Target)
-	{
-		Type = TargetType.Game;
-		DefaultBuildSettings = BuildSettingsVersion.V2;
-		ExtraModuleNames.AddRange( new string[] { "DBTPluginProject" } );
-	}
-}
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class DBTPluginProjectTarget : TargetRules
+{
+	public DBTPluginProjectTarget( TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Game;
+		DefaultBuildSettings = BuildSettingsVersion.V2;
+		bWithPushModel = true;
+		ExtraModuleNames.AddRange( new string[] { "DBTPluginProject" } );
+	}
+}
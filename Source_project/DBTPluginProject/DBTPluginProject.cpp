@@ -1,6 +1,6 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "DBTPluginProject.h"
-#include "Modules/ModuleManager.h"
-
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, DBTPluginProject, "DBTPluginProject" );
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DBTPluginProject.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, DBTPluginProject, "DBTPluginProject" );
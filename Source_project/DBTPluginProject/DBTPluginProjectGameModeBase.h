@@ -1,14 +1,14 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/GameModeBase.h"
-#include "DBTPluginProjectGameModeBase.generated.h"
-
-UCLASS()
-class DBTPLUGINPROJECT_API ADBTPluginProjectGameModeBase : public AGameModeBase
-{
-	GENERATED_BODY()
-	
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "DBTPluginProjectGameModeBase.generated.h"
+
+UCLASS()
+class DBTPLUGINPROJECT_API ADBTPluginProjectGameModeBase : public AGameModeBase
+{
+	GENERATED_BODY()
+	
+};
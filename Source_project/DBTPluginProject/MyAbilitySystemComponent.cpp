@@ -1,8 +1,8 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "MyAbilitySystemComponent.h"
-
-UMyAbilitySystemComponent::UMyAbilitySystemComponent()
-{
-    // Constructor
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MyAbilitySystemComponent.h"
+
+UMyAbilitySystemComponent::UMyAbilitySystemComponent()
+{
+    // Constructor
 }
\ No newline at end of file
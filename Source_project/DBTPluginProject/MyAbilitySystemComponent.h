@@ -1,15 +1,15 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-#include "CoreMinimal.h"
-#include "AbilitySystemComponent.h"
-#include "MyAbilitySystemComponent.generated.h"
-
-UCLASS()
-class DBTPLUGINPROJECT_API UMyAbilitySystemComponent : public UAbilitySystemComponent
-{
-    GENERATED_BODY()
-
-public:
-    UMyAbilitySystemComponent();
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "AbilitySystemComponent.h"
+#include "MyAbilitySystemComponent.generated.h"
+
+UCLASS()
+class DBTPLUGINPROJECT_API UMyAbilitySystemComponent : public UAbilitySystemComponent
+{
+    GENERATED_BODY()
+
+public:
+    UMyAbilitySystemComponent();
 };
\ No newline at end of file
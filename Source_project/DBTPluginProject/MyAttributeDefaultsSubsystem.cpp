@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MyAttributeDefaultsSubsystem.h"
+#include "MyGASCharacter.h"
+#include "MyAttributeSet.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+
+bool UMyAttributeDefaultsSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld();
+}
+
+void UMyAttributeDefaultsSubsystem::Deinitialize()
+{
+    PendingCharacters.Empty();
+    ResolvedDefaults.Empty();
+    DefaultsIndices.Empty();
+
+    Super::Deinitialize();
+}
+
+int32 UMyAttributeDefaultsSubsystem::ResolveDefaultsIndex(const UDataTable* DataTable, FName RowName)
+{
+    const FRowKey Key{ FObjectKey(DataTable), RowName };
+    if (const int32* Index = DefaultsIndices.Find(Key))
+    {
+        return *Index;
+    }
+
+    int32 Index = INDEX_NONE;
+    if (const FMyCharacterAttributeDefaults* Row = DataTable->FindRow<FMyCharacterAttributeDefaults>(RowName, TEXT("AttributeDefaults")))
+    {
+        Index = ResolvedDefaults.Add(*Row);
+    }
+    else
+    {
+        GLog->Logf(ELogVerbosity::Warning, TEXT("AttributeDefaults: Row %s not found in %s"), *RowName.ToString(), *DataTable->GetName());
+    }
+
+    DefaultsIndices.Add(Key, Index);
+    return Index;
+}
+
+bool UMyAttributeDefaultsSubsystem::FindDefaults(const UDataTable* DataTable, FName RowName, FMyCharacterAttributeDefaults& OutDefaults)
+{
+    if (!DataTable)
+    {
+        return false;
+    }
+
+    const int32 Index = ResolveDefaultsIndex(DataTable, RowName);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutDefaults = ResolvedDefaults[Index];
+    return true;
+}
+
+void UMyAttributeDefaultsSubsystem::QueueAttributeDefaults(AMyGASCharacter* Character)
+{
+    if (!Character || !Character->HasAuthority() || !Character->GetAttributeDefaultsTable())
+    {
+        return;
+    }
+
+    const int32 DefaultsIndex = ResolveDefaultsIndex(Character->GetAttributeDefaultsTable(), Character->GetAttributeDefaultsRow());
+    if (DefaultsIndex != INDEX_NONE)
+    {
+        PendingCharacters.Add(FPendingCharacter{ Character, DefaultsIndex });
+    }
+}
+
+void UMyAttributeDefaultsSubsystem::FlushPendingDefaults()
+{
+    if (PendingCharacters.Num() == 0)
+    {
+        return;
+    }
+
+    // Characters sharing a row are written back to back
+    PendingCharacters.Sort([](const FPendingCharacter& A, const FPendingCharacter& B)
+    {
+        return A.DefaultsIndex < B.DefaultsIndex;
+    });
+
+    int32 InitializedCount = 0;
+    for (const FPendingCharacter& Pending : PendingCharacters)
+    {
+        AMyGASCharacter* Character = Pending.Character.Get();
+        UMyAttributeSet* AttributeSet = Character ? Character->GetAttributeSet() : nullptr;
+        if (!AttributeSet)
+        {
+            continue;
+        }
+
+        const FMyCharacterAttributeDefaults& Defaults = ResolvedDefaults[Pending.DefaultsIndex];
+        AttributeSet->InitMaxHealth(Defaults.MaxHealth);
+        AttributeSet->InitHealth(Defaults.Health);
+        AttributeSet->InitMaxMana(Defaults.MaxMana);
+        AttributeSet->InitMana(Defaults.Mana);
+        AttributeSet->InitMoveSpeed(Defaults.MoveSpeed);
+        InitializedCount++;
+    }
+
+    PendingCharacters.Reset();
+
+    GLog->Logf(ELogVerbosity::Display, TEXT("AttributeDefaults: Initialized %d character(s)"), InitializedCount);
+}
+
+void UMyAttributeDefaultsSubsystem::Tick(float DeltaTime)
+{
+    FlushPendingDefaults();
+}
+
+ETickableTickType UMyAttributeDefaultsSubsystem::GetTickableTickType() const
+{
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UMyAttributeDefaultsSubsystem::IsTickable() const
+{
+    return PendingCharacters.Num() > 0;
+}
+
+TStatId UMyAttributeDefaultsSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UMyAttributeDefaultsSubsystem, STATGROUP_Tickables);
+}
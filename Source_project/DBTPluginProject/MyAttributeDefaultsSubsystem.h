@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+#include "MyGamesTypes.h"
+#include "MyAttributeDefaultsSubsystem.generated.h"
+
+class AMyGASCharacter;
+class UDataTable;
+
+/**
+ * Applies FMyCharacterAttributeDefaults rows to spawned characters.
+ * Rows are resolved once per (table, row) into a flat cache, and characters spawned during a
+ * frame are initialized together at the end of it by writing the attribute set directly, so a
+ * mass spawn costs neither a DataTable lookup nor a gameplay effect per character.
+ */
+UCLASS()
+class DBTPLUGINPROJECT_API UMyAttributeDefaultsSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+    virtual void Deinitialize() override;
+
+    /** Queues Character for initialization with the row it references. Authority only. */
+    void QueueAttributeDefaults(AMyGASCharacter* Character);
+
+    /** Initializes every queued character now. */
+    void FlushPendingDefaults();
+
+    /** Copies the resolved row into OutDefaults; returns false if the table or row is missing. */
+    bool FindDefaults(const UDataTable* DataTable, FName RowName, FMyCharacterAttributeDefaults& OutDefaults);
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    struct FRowKey
+    {
+        FObjectKey DataTable;
+        FName RowName;
+
+        bool operator==(const FRowKey& Other) const { return DataTable == Other.DataTable && RowName == Other.RowName; }
+
+        friend uint32 GetTypeHash(const FRowKey& Key) { return HashCombine(GetTypeHash(Key.DataTable), GetTypeHash(Key.RowName)); }
+    };
+
+    struct FPendingCharacter
+    {
+        TWeakObjectPtr<AMyGASCharacter> Character;
+        int32 DefaultsIndex = INDEX_NONE;
+    };
+
+    int32 ResolveDefaultsIndex(const UDataTable* DataTable, FName RowName);
+
+    // Resolved rows; INDEX_NONE in the index map remembers rows that are missing
+    TArray<FMyCharacterAttributeDefaults> ResolvedDefaults;
+    TMap<FRowKey, int32> DefaultsIndices;
+
+    TArray<FPendingCharacter> PendingCharacters;
+};
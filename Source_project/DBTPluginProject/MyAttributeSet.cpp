@@ -1,46 +1,155 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "MyAttributeSet.h"
-#include "Net/UnrealNetwork.h"
-#include "GameplayEffectExtension.h"
-
-UMyAttributeSet::UMyAttributeSet()
-{
-    // Initialize default values if needed
-}
-
-void UMyAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
-{
-    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-    DOREPLIFETIME_CONDITION_NOTIFY(UMyAttributeSet, Health, COND_None, REPNOTIFY_Always);
-    DOREPLIFETIME_CONDITION_NOTIFY(UMyAttributeSet, MaxHealth, COND_None, REPNOTIFY_Always);
-    DOREPLIFETIME_CONDITION_NOTIFY(UMyAttributeSet, Mana, COND_None, REPNOTIFY_Always);
-    DOREPLIFETIME_CONDITION_NOTIFY(UMyAttributeSet, MaxMana, COND_None, REPNOTIFY_Always);
-    DOREPLIFETIME_CONDITION_NOTIFY(UMyAttributeSet, MoveSpeed, COND_None, REPNOTIFY_Always);
-}
-
-void UMyAttributeSet::OnRep_Health(const FGameplayAttributeData& OldHealth)
-{
-    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, Health, OldHealth);
-}
-
-void UMyAttributeSet::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
-{
-    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, MaxHealth, OldMaxHealth);
-}
-
-void UMyAttributeSet::OnRep_Mana(const FGameplayAttributeData& OldMana)
-{
-    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, Mana, OldMana);
-}
-
-void UMyAttributeSet::OnRep_MaxMana(const FGameplayAttributeData& OldMaxMana)
-{
-    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, MaxMana, OldMaxMana);
-}
-
-void UMyAttributeSet::OnRep_MoveSpeed(const FGameplayAttributeData& OldMoveSpeed)
-{
-    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, MoveSpeed, OldMoveSpeed);
-}
\ No newline at end of file
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MyAttributeSet.h"
+#include "Net/UnrealNetwork.h"
+#include "GameplayEffectExtension.h"
+#include "MyGASCharacter.h"
+#include "MyMeasuredActorChannel.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "EngineUtils.h"
+#include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+
+UMyAttributeSet::UMyAttributeSet()
+{
+    // Initialize default values if needed
+}
+
+void UMyAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    FDoRepLifetimeParams Params;
+    Params.bIsPushBased = true;
+    Params.RepNotifyCondition = REPNOTIFY_Always;
+
+    Params.Condition = COND_None;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UMyAttributeSet, Health, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UMyAttributeSet, MaxHealth, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UMyAttributeSet, MoveSpeed, Params);
+
+    // Only the owning player needs its resource pool
+    Params.Condition = COND_OwnerOnly;
+    DOREPLIFETIME_WITH_PARAMS_FAST(UMyAttributeSet, Mana, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(UMyAttributeSet, MaxMana, Params);
+}
+
+void UMyAttributeSet::MarkAttributeDirty(const FGameplayAttribute& Attribute)
+{
+    if (Attribute == GetHealthAttribute())
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UMyAttributeSet, Health, this);
+    }
+    else if (Attribute == GetMaxHealthAttribute())
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UMyAttributeSet, MaxHealth, this);
+    }
+    else if (Attribute == GetManaAttribute())
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UMyAttributeSet, Mana, this);
+    }
+    else if (Attribute == GetMaxManaAttribute())
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UMyAttributeSet, MaxMana, this);
+    }
+    else if (Attribute == GetMoveSpeedAttribute())
+    {
+        MARK_PROPERTY_DIRTY_FROM_NAME(UMyAttributeSet, MoveSpeed, this);
+    }
+}
+
+void UMyAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
+{
+    Super::PreAttributeChange(Attribute, NewValue);
+
+    // Base value writes through the ASC also end here, as the current value is updated after them
+    MarkAttributeDirty(Attribute);
+}
+
+void UMyAttributeSet::OnRep_Health(const FGameplayAttributeData& OldHealth)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, Health, OldHealth);
+}
+
+void UMyAttributeSet::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, MaxHealth, OldMaxHealth);
+}
+
+void UMyAttributeSet::OnRep_Mana(const FGameplayAttributeData& OldMana)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, Mana, OldMana);
+}
+
+void UMyAttributeSet::OnRep_MaxMana(const FGameplayAttributeData& OldMaxMana)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, MaxMana, OldMaxMana);
+}
+
+void UMyAttributeSet::OnRep_MoveSpeed(const FGameplayAttributeData& OldMoveSpeed)
+{
+    GAMEPLAYATTRIBUTE_REPNOTIFY(UMyAttributeSet, MoveSpeed, OldMoveSpeed);
+}
+
+// Usage: my.Net.MeasureReplication [Seconds]
+// Reports the bits the server sent on the actor channels of each AMyGASCharacter over the window,
+// which includes their attribute sets. Compare runs with net.IsPushModelEnabled 0 and 1 to see
+// what the push-model attributes save.
+static FAutoConsoleCommandWithWorldAndArgs MeasureReplicationCommand(
+    TEXT("my.Net.MeasureReplication"),
+    TEXT("Measures outgoing replication bytes per second of each AMyGASCharacter over a window (default 10 seconds)."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+        if (!NetDriver || !NetDriver->IsServer())
+        {
+            GLog->Logf(ELogVerbosity::Warning, TEXT("MeasureReplication: Must run on a server"));
+            return;
+        }
+
+        if (!UMyMeasuredActorChannel::IsInstalled())
+        {
+            GLog->Logf(ELogVerbosity::Warning, TEXT("MeasureReplication: The measuring actor channel is not installed (shipping build?)"));
+            return;
+        }
+
+        const float Seconds = Args.Num() > 0 ? FMath::Max(1.0f, FCString::Atof(*Args[0])) : 10.0f;
+        const double StartTime = FPlatformTime::Seconds();
+        UMyMeasuredActorChannel::BeginMeasurement();
+
+        GLog->Logf(ELogVerbosity::Display, TEXT("MeasureReplication: Sampling for %.1f seconds (push model %s)"),
+            Seconds, IS_PUSH_MODEL_ENABLED() ? TEXT("enabled") : TEXT("disabled"));
+
+        TWeakObjectPtr<UWorld> WeakWorld(World);
+        FTimerHandle TimerHandle;
+        World->GetTimerManager().SetTimer(TimerHandle, FTimerDelegate::CreateLambda([WeakWorld, StartTime]()
+        {
+            const TMap<FObjectKey, int64> BitsPerActor = UMyMeasuredActorChannel::EndMeasurement();
+            const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+            UWorld* World = WeakWorld.Get();
+            if (!World)
+            {
+                return;
+            }
+
+            int64 TotalBits = 0;
+            int32 CharacterCount = 0;
+            for (TActorIterator<AMyGASCharacter> It(World); It; ++It)
+            {
+                const int64* Bits = BitsPerActor.Find(FObjectKey(*It));
+                const int64 CharacterBits = Bits ? *Bits : 0;
+
+                GLog->Logf(ELogVerbosity::Display, TEXT("MeasureReplication: %s %.1f bytes/s"), *It->GetName(), CharacterBits / 8.0 / Elapsed);
+
+                TotalBits += CharacterBits;
+                CharacterCount++;
+            }
+
+            const double BytesPerSecond = TotalBits / 8.0 / Elapsed;
+            GLog->Logf(ELogVerbosity::Display, TEXT("MeasureReplication: %.0f bytes/s on character channels, %d character(s), %.1f bytes/s per character"),
+                BytesPerSecond, CharacterCount, CharacterCount > 0 ? BytesPerSecond / CharacterCount : 0.0);
+        }), Seconds, false);
+    }));
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MyMeasuredActorChannel.h"
+#include "MyGASCharacter.h"
+#include "Engine/NetDriver.h"
+#include "Net/DataBunch.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "UObject/UObjectIterator.h"
+
+bool UMyMeasuredActorChannel::bInstalled = false;
+bool UMyMeasuredActorChannel::bMeasuring = false;
+TMap<FObjectKey, int64> UMyMeasuredActorChannel::BitsPerActor;
+
+UMyMeasuredActorChannel::UMyMeasuredActorChannel(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+}
+
+FPacketIdRange UMyMeasuredActorChannel::SendBunch(FOutBunch* Bunch, bool Merge)
+{
+    if (bMeasuring && Bunch && Actor && Actor->IsA<AMyGASCharacter>())
+    {
+        BitsPerActor.FindOrAdd(FObjectKey(Actor)) += Bunch->GetNumBits();
+    }
+
+    return Super::SendBunch(Bunch, Merge);
+}
+
+void UMyMeasuredActorChannel::Install()
+{
+    const FName ClassName(*GetPathNameSafe(StaticClass()));
+
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        if (!It->IsChildOf(UNetDriver::StaticClass()) || It->HasAnyClassFlags(CLASS_Abstract))
+        {
+            continue;
+        }
+
+        for (FChannelDefinition& Definition : It->GetDefaultObject<UNetDriver>()->ChannelDefinitions)
+        {
+            if (Definition.ChannelName == NAME_Actor)
+            {
+                Definition.ClassName = ClassName;
+                bInstalled = true;
+            }
+        }
+    }
+}
+
+void UMyMeasuredActorChannel::BeginMeasurement()
+{
+    BitsPerActor.Reset();
+    bMeasuring = true;
+}
+
+TMap<FObjectKey, int64> UMyMeasuredActorChannel::EndMeasurement()
+{
+    bMeasuring = false;
+    return MoveTemp(BitsPerActor);
+}
+
+#if !UE_BUILD_SHIPPING
+static FDelayedAutoRegisterHelper InstallMeasuredActorChannel(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+{
+    UMyMeasuredActorChannel::Install();
+});
+#endif
@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/ActorChannel.h"
+#include "UObject/ObjectKey.h"
+#include "MyMeasuredActorChannel.generated.h"
+
+/**
+ * Actor channel that counts the bits it sends for AMyGASCharacter actors while a measurement
+ * is running, so my.Net.MeasureReplication can report per-character replication cost instead of
+ * all server traffic. Installed as the Actor channel class of every net driver in non-shipping builds.
+ */
+UCLASS(transient)
+class DBTPLUGINPROJECT_API UMyMeasuredActorChannel : public UActorChannel
+{
+    GENERATED_BODY()
+
+public:
+    UMyMeasuredActorChannel(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+    virtual FPacketIdRange SendBunch(FOutBunch* Bunch, bool Merge) override;
+
+    /** Points the Actor channel definition of all net driver classes at this class; affects drivers created afterwards. */
+    static void Install();
+
+    static bool IsInstalled() { return bInstalled; }
+
+    static void BeginMeasurement();
+
+    /** Stops counting and returns the bits sent per character since BeginMeasurement. */
+    static TMap<FObjectKey, int64> EndMeasurement();
+
+private:
+    static bool bInstalled;
+    static bool bMeasuring;
+    static TMap<FObjectKey, int64> BitsPerActor;
+};
@@ -1,20 +1,20 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-#include "CoreMinimal.h"
-#include "GameFramework/PlayerController.h"
-#include "MyPlayerController.generated.h"
-
-UCLASS()
-class DBTPLUGINPROJECT_API AMyPlayerController : public APlayerController
-{
-    GENERATED_BODY()
-
-protected:
-    virtual void SetupInputComponent() override;
-    virtual void BeginPlay() override;
-
-private:
-    void ActivateTestAbility();
-    void ShowStats();
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "MyPlayerController.generated.h"
+
+UCLASS()
+class DBTPLUGINPROJECT_API AMyPlayerController : public APlayerController
+{
+    GENERATED_BODY()
+
+protected:
+    virtual void SetupInputComponent() override;
+    virtual void BeginPlay() override;
+
+private:
+    void ActivateTestAbility();
+    void ShowStats();
 };
\ No newline at end of file